@@ -52,6 +52,49 @@ int p2G4_dev_req_rx2v1_c_b(p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rx
   return p2G4_dev_req_rx2v1_s_c_b(&C2G4_dev_st, rx_s, phy_addr, rx_done_s, buf, size, eval_f);
 }
 
+int p2G4_dev_req_rx_stream_c_b(p2G4_rx_stream_t *rx_s, p2G4_address_t *phy_addr, p2G4_freq2_t *channels,
+                               p2G4_rxv2_done_t *rx_done_s, uint8_t **buf, size_t size,
+                               device_eval_rxv2_f eval_f, device_rx_stream_packet_f packet_f){
+  return p2G4_dev_req_rx_stream_s_c_b(&C2G4_dev_st, rx_s, phy_addr, channels, rx_done_s, buf, size,
+                                      eval_f, packet_f);
+}
+
+int p2G4_dev_req_rx_multi_c_b(p2G4_rx_multi_t *multi_s, p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr,
+                              p2G4_rxv2_done_t *done_s, uint8_t **rx_bufs, size_t buf_size){
+  return p2G4_dev_req_rx_multi_s_c_b(&C2G4_dev_st, multi_s, rxs, phy_addr, done_s, rx_bufs, buf_size);
+}
+
+int p2G4_dev_req_rx_chain_c_b(p2G4_rx_chain_t *chain, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr,
+                              p2G4_rx_chain_seg_t *segs, p2G4_rx_chain_done_t *done_s,
+                              uint8_t **buf, size_t size){
+  return p2G4_dev_req_rx_chain_s_c_b(&C2G4_dev_st, chain, rx_s, phy_addr, segs, done_s, buf, size);
+}
+
+int p2G4_dev_req_txrx_c_b(p2G4_txrx_t *txrx_s, p2G4_address_t *phy_addr, uint8_t *packet,
+                          p2G4_txrx_done_t *done_s, uint8_t **buf, size_t size,
+                          device_eval_rxv2_f eval_f){
+  return p2G4_dev_req_txrx_s_c_b(&C2G4_dev_st, txrx_s, phy_addr, packet, done_s, buf, size, eval_f);
+}
+
+int p2G4_dev_req_rx_autoresp_c_b(p2G4_rx_autoresp_t *ar_s, p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules,
+                                 uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **buf, size_t size,
+                                 device_eval_rxv2_f eval_f){
+  return p2G4_dev_req_rx_autoresp_s_c_b(&C2G4_dev_st, ar_s, phy_addr, rules, packet, done_s, buf, size, eval_f);
+}
+
+int p2G4_dev_req_tx2v1_posted_c(p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s) {
+  return p2G4_dev_req_tx2v1_posted_s_c(&C2G4_dev_st, tx_s, packet, tx_done_s);
+}
+
+int p2G4_dev_req_tx_chain_c_b(p2G4_tx_chain_t *chain, p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s) {
+  return p2G4_dev_req_tx_chain_s_c_b(&C2G4_dev_st, chain, segs, packet, done_s);
+}
+
+int p2G4_dev_req_cca_tx_c_b(p2G4_cca_tx_t *cca_tx_s, uint32_t *backoffs, uint8_t *packet,
+                            p2G4_cca_tx_done_t *done_s){
+  return p2G4_dev_req_cca_tx_s_c_b(&C2G4_dev_st, cca_tx_s, backoffs, packet, done_s);
+}
+
 int p2G4_dev_req_RSSI_c_b(p2G4_rssi_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s) {
   return p2G4_dev_req_RSSI_s_c_b(&C2G4_dev_st, RSSI_s, RSSI_done_s);
 }
@@ -60,6 +103,10 @@ int p2G4_dev_req_RSSIv2_c_b(p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s
   return p2G4_dev_req_RSSIv2_s_c_b(&C2G4_dev_st, RSSI_s, RSSI_done_s);
 }
 
+int p2G4_dev_req_rssi_sweep_c_b(p2G4_rssi_sweep_t *sweep_s, p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi) {
+  return p2G4_dev_req_rssi_sweep_s_c_b(&C2G4_dev_st, sweep_s, freqs, rssi);
+}
+
 int p2G4_dev_req_cca_c_b(p2G4_cca_t *cca_s, p2G4_cca_done_t *cca_done_s) {
   return p2G4_dev_req_cca_s_c_b(&C2G4_dev_st, cca_s, cca_done_s);
 }
@@ -68,10 +115,78 @@ int p2G4_dev_req_ccav2_c_b(p2G4_ccav2_t *cca_s, p2G4_cca_done_t *cca_done_s) {
   return p2G4_dev_req_ccav2_s_c_b(&C2G4_dev_st, cca_s, cca_done_s);
 }
 
+int p2G4_dev_req_cca_multi_c_b(p2G4_cca_multi_t *cca_s, p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s) {
+  return p2G4_dev_req_cca_multi_s_c_b(&C2G4_dev_st, cca_s, freqs, cca_done_s);
+}
+
 int p2G4_dev_req_wait_c_b(pb_wait_t *wait_s){
   return p2G4_dev_req_wait_s_c_b(&C2G4_dev_st, wait_s);
 }
 
+int p2G4_dev_set_abort_sched_c(p2G4_abort_t *steps, uint n_steps){
+  return p2G4_dev_set_abort_sched_s_c(&C2G4_dev_st, steps, n_steps);
+}
+
+int p2G4_dev_set_rx_filter_c(p2G4_rx_filter_t *filter, p2G4_rx_filter_rule_t *rules){
+  return p2G4_dev_set_rx_filter_s_c(&C2G4_dev_st, filter, rules);
+}
+
+int p2G4_dev_set_rx_rssi_series_c(p2G4_rssi_series_t *series){
+  return p2G4_dev_set_rx_rssi_series_s_c(&C2G4_dev_st, series);
+}
+
+int p2G4_dev_addr_set_register_c(p2G4_address_t *addr, uint32_t n_addr, uint32_t *handle){
+  return p2G4_dev_addr_set_register_s_c(&C2G4_dev_st, addr, n_addr, handle);
+}
+
+int p2G4_dev_addr_set_release_c(uint32_t handle){
+  return p2G4_dev_addr_set_release_s_c(&C2G4_dev_st, handle);
+}
+
+int p2G4_dev_set_rx_addr_set_c(uint32_t handle){
+  return p2G4_dev_set_rx_addr_set_s_c(&C2G4_dev_st, handle);
+}
+
+int p2G4_dev_tmpl_register_tx2v1_c(p2G4_tx2v1_t *tx_s, uint32_t *handle){
+  return p2G4_dev_tmpl_register_tx2v1_s_c(&C2G4_dev_st, tx_s, handle);
+}
+
+int p2G4_dev_tmpl_register_rx2v1_c(p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, uint32_t *handle){
+  return p2G4_dev_tmpl_register_rx2v1_s_c(&C2G4_dev_st, rx_s, phy_addr, handle);
+}
+
+int p2G4_dev_use_tmpl_c(uint32_t handle){
+  return p2G4_dev_use_tmpl_s_c(&C2G4_dev_st, handle);
+}
+
+int p2G4_dev_rx_fetch_payload_c(uint16_t offset, uint16_t size, uint8_t *buf){
+  return p2G4_dev_rx_fetch_payload_s_c(&C2G4_dev_st, offset, size, buf);
+}
+
+void p2G4_dev_rx_get_progress_c(p2G4_rx_progress_t *progress){
+  p2G4_dev_rx_get_progress_s_c(&C2G4_dev_st, progress);
+}
+
+int p2G4_dev_req_imm_error_mask_c_b(uint32_t start_bit){
+  return p2G4_dev_req_imm_error_mask_s_c_b(&C2G4_dev_st, start_bit);
+}
+
+void p2G4_dev_rx_get_error_mask_c(p2G4_rx_error_mask_t *mask){
+  p2G4_dev_rx_get_error_mask_s_c(&C2G4_dev_st, mask);
+}
+
+void p2G4_dev_rx_get_rssi_samples_c(p2G4_rx_rssi_samples_t *samples){
+  p2G4_dev_rx_get_rssi_samples_s_c(&C2G4_dev_st, samples);
+}
+
+void p2G4_dev_rx_pool_release_c(uint8_t *buf){
+  p2G4_dev_rx_pool_release_s_c(&C2G4_dev_st, buf);
+}
+
+void p2G4_dev_rx_pool_get_stats_c(p2G4_rx_pool_stats_t *stats){
+  p2G4_dev_rx_pool_get_stats_s_c(&C2G4_dev_st, stats);
+}
+
 
 /*
  * Set of functions without callbacks:
@@ -104,6 +219,19 @@ int p2G4_dev_req_tx2v1_nc_b(p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t
   return p2G4_dev_req_tx2v1_s_nc_b(&C2G4_dev_st_nc, tx_s, packet, tx_done_s);
 }
 
+int p2G4_dev_req_tx2v1_posted_nc(p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s) {
+  return p2G4_dev_req_tx2v1_posted_s_nc(&C2G4_dev_st_nc, tx_s, packet, tx_done_s);
+}
+
+int p2G4_dev_req_tx_chain_nc_b(p2G4_tx_chain_t *chain, p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s) {
+  return p2G4_dev_req_tx_chain_s_nc_b(&C2G4_dev_st_nc, chain, segs, packet, done_s);
+}
+
+int p2G4_dev_req_cca_tx_nc_b(p2G4_cca_tx_t *cca_tx_s, uint32_t *backoffs, uint8_t *packet,
+                             p2G4_cca_tx_done_t *done_s){
+  return p2G4_dev_req_cca_tx_s_nc_b(&C2G4_dev_st_nc, cca_tx_s, backoffs, packet, done_s);
+}
+
 int p2G4_dev_provide_new_tx_abort_nc_b(p2G4_abort_t * abort){
   return p2G4_dev_provide_new_tx_abort_s_nc_b(&C2G4_dev_st_nc, abort);
 }
@@ -120,6 +248,46 @@ int p2G4_dev_req_rx2v1_nc_b(p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_r
   return p2G4_dev_req_rx2v1_s_nc_b(&C2G4_dev_st_nc, rx_s, phy_addr, rx_done_s, buf, size);
 }
 
+int p2G4_dev_req_rx_stream_nc_b(p2G4_rx_stream_t *rx_s, p2G4_address_t *phy_addr, p2G4_freq2_t *channels,
+                                p2G4_rxv2_done_t *rx_done_s, uint8_t **buf, size_t size){
+  return p2G4_dev_req_rx_stream_s_nc_b(&C2G4_dev_st_nc, rx_s, phy_addr, channels, rx_done_s, buf, size);
+}
+
+int p2G4_dev_rx_stream_next_nc_b(void){
+  return p2G4_dev_rx_stream_next_s_nc_b(&C2G4_dev_st_nc);
+}
+
+int p2G4_dev_rx_stream_stop_nc_b(void){
+  return p2G4_dev_rx_stream_stop_s_nc_b(&C2G4_dev_st_nc);
+}
+
+int p2G4_dev_req_rx_multi_nc_b(p2G4_rx_multi_t *multi_s, p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr,
+                               p2G4_rxv2_done_t *done_s, p2G4_rx_multi_tag_t *tag_s,
+                               uint8_t **rx_bufs, size_t buf_size){
+  return p2G4_dev_req_rx_multi_s_nc_b(&C2G4_dev_st_nc, multi_s, rxs, phy_addr, done_s, tag_s,
+                                      rx_bufs, buf_size);
+}
+
+int p2G4_dev_rx_multi_next_nc_b(void){
+  return p2G4_dev_rx_multi_next_s_nc_b(&C2G4_dev_st_nc);
+}
+
+int p2G4_dev_req_rx_chain_nc_b(p2G4_rx_chain_t *chain, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr,
+                               p2G4_rx_chain_seg_t *segs, p2G4_rx_chain_done_t *done_s,
+                               uint8_t **buf, size_t size){
+  return p2G4_dev_req_rx_chain_s_nc_b(&C2G4_dev_st_nc, chain, rx_s, phy_addr, segs, done_s, buf, size);
+}
+
+int p2G4_dev_req_txrx_nc_b(p2G4_txrx_t *txrx_s, p2G4_address_t *phy_addr, uint8_t *packet,
+                           p2G4_txrx_done_t *done_s, uint8_t **buf, size_t size){
+  return p2G4_dev_req_txrx_s_nc_b(&C2G4_dev_st_nc, txrx_s, phy_addr, packet, done_s, buf, size);
+}
+
+int p2G4_dev_req_rx_autoresp_nc_b(p2G4_rx_autoresp_t *ar_s, p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules,
+                                  uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **buf, size_t size){
+  return p2G4_dev_req_rx_autoresp_s_nc_b(&C2G4_dev_st_nc, ar_s, phy_addr, rules, packet, done_s, buf, size);
+}
+
 int p2G4_dev_rx_cont_after_addr_nc_b(bool accept_rx){
   return p2G4_dev_rx_cont_after_addr_s_nc_b(&C2G4_dev_st_nc, accept_rx);
 }
@@ -148,6 +316,10 @@ int p2G4_dev_req_RSSIv2_nc_b(p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_
   return p2G4_dev_req_RSSIv2_s_nc_b(&C2G4_dev_st_nc, RSSI_s, RSSI_done_s);
 }
 
+int p2G4_dev_req_rssi_sweep_nc_b(p2G4_rssi_sweep_t *sweep_s, p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi) {
+  return p2G4_dev_req_rssi_sweep_s_nc_b(&C2G4_dev_st_nc, sweep_s, freqs, rssi);
+}
+
 int p2G4_dev_req_wait_nc_b(pb_wait_t *wait_s){
   return p2G4_dev_req_wait_s_nc_b(&C2G4_dev_st_nc, wait_s);
 }
@@ -160,6 +332,74 @@ int p2G4_dev_req_ccav2_nc_b(p2G4_ccav2_t *cca_s, p2G4_cca_done_t *cca_done_s) {
   return p2G4_dev_req_ccav2_s_nc_b(&C2G4_dev_st_nc, cca_s, cca_done_s);
 }
 
+int p2G4_dev_req_cca_multi_nc_b(p2G4_cca_multi_t *cca_s, p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s) {
+  return p2G4_dev_req_cca_multi_s_nc_b(&C2G4_dev_st_nc, cca_s, freqs, cca_done_s);
+}
+
 int p2G4_dev_provide_new_cca_abort_nc_b(p2G4_abort_t * abort){
   return p2G4_dev_provide_new_cca_abort_s_nc_b(&C2G4_dev_st_nc, abort);
 }
+
+int p2G4_dev_set_abort_sched_nc(p2G4_abort_t *steps, uint n_steps){
+  return p2G4_dev_set_abort_sched_s_nc(&C2G4_dev_st_nc, steps, n_steps);
+}
+
+int p2G4_dev_set_rx_filter_nc(p2G4_rx_filter_t *filter, p2G4_rx_filter_rule_t *rules){
+  return p2G4_dev_set_rx_filter_s_nc(&C2G4_dev_st_nc, filter, rules);
+}
+
+int p2G4_dev_set_rx_rssi_series_nc(p2G4_rssi_series_t *series){
+  return p2G4_dev_set_rx_rssi_series_s_nc(&C2G4_dev_st_nc, series);
+}
+
+int p2G4_dev_addr_set_register_nc(p2G4_address_t *addr, uint32_t n_addr, uint32_t *handle){
+  return p2G4_dev_addr_set_register_s_nc(&C2G4_dev_st_nc, addr, n_addr, handle);
+}
+
+int p2G4_dev_addr_set_release_nc(uint32_t handle){
+  return p2G4_dev_addr_set_release_s_nc(&C2G4_dev_st_nc, handle);
+}
+
+int p2G4_dev_set_rx_addr_set_nc(uint32_t handle){
+  return p2G4_dev_set_rx_addr_set_s_nc(&C2G4_dev_st_nc, handle);
+}
+
+int p2G4_dev_tmpl_register_tx2v1_nc(p2G4_tx2v1_t *tx_s, uint32_t *handle){
+  return p2G4_dev_tmpl_register_tx2v1_s_nc(&C2G4_dev_st_nc, tx_s, handle);
+}
+
+int p2G4_dev_tmpl_register_rx2v1_nc(p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, uint32_t *handle){
+  return p2G4_dev_tmpl_register_rx2v1_s_nc(&C2G4_dev_st_nc, rx_s, phy_addr, handle);
+}
+
+int p2G4_dev_use_tmpl_nc(uint32_t handle){
+  return p2G4_dev_use_tmpl_s_nc(&C2G4_dev_st_nc, handle);
+}
+
+int p2G4_dev_rx_fetch_payload_nc(uint16_t offset, uint16_t size, uint8_t *buf){
+  return p2G4_dev_rx_fetch_payload_s_nc(&C2G4_dev_st_nc, offset, size, buf);
+}
+
+void p2G4_dev_rx_get_progress_nc(p2G4_rx_progress_t *progress){
+  p2G4_dev_rx_get_progress_s_nc(&C2G4_dev_st_nc, progress);
+}
+
+int p2G4_dev_req_imm_error_mask_nc_b(uint32_t start_bit){
+  return p2G4_dev_req_imm_error_mask_s_nc_b(&C2G4_dev_st_nc, start_bit);
+}
+
+void p2G4_dev_rx_get_error_mask_nc(p2G4_rx_error_mask_t *mask){
+  p2G4_dev_rx_get_error_mask_s_nc(&C2G4_dev_st_nc, mask);
+}
+
+void p2G4_dev_rx_get_rssi_samples_nc(p2G4_rx_rssi_samples_t *samples){
+  p2G4_dev_rx_get_rssi_samples_s_nc(&C2G4_dev_st_nc, samples);
+}
+
+void p2G4_dev_rx_pool_release_nc(uint8_t *buf){
+  p2G4_dev_rx_pool_release_s_nc(&C2G4_dev_st_nc, buf);
+}
+
+void p2G4_dev_rx_pool_get_stats_nc(p2G4_rx_pool_stats_t *stats){
+  p2G4_dev_rx_pool_get_stats_s_nc(&C2G4_dev_st_nc, stats);
+}
@@ -9,6 +9,7 @@
 #include "bs_pc_2G4_types.h"
 #include "bs_pc_base.h"
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"{
@@ -50,6 +51,156 @@ extern "C"{
  * Except the initcom functions which are always blocking
  */
 
+/*
+ * Pool of reception buffers (see p2G4_dev_rx_pool_release_*())
+ * Internal to libCom, devices shall not access it.
+ */
+typedef struct {
+  union p2G4_rx_pool_hdr *free_list;
+  uint n_free;
+  /* Size of each buffer (biggest packet_size seen so far) */
+  size_t buf_size;
+  uint64_t hits;
+  uint64_t misses;
+} p2G4_rx_pool_t;
+
+typedef struct {
+  /* Number of buffers served from the pool */
+  uint64_t hits;
+  /* Number of buffers which had to be allocated */
+  uint64_t misses;
+  /* Current size of each buffer */
+  size_t buf_size;
+  /* Number of buffers currently in the pool */
+  uint n_free;
+} p2G4_rx_pool_stats_t;
+
+/*
+ * Pass this value as buf_size to any p2G4_dev_req_rx*() to have the packet
+ * placed in a buffer from the connection pool.
+ * The device shall give it back with p2G4_dev_rx_pool_release_*()
+ */
+#define P2G4_RXBUF_FROM_POOL SIZE_MAX
+
+/*
+ * Progress of the packet being received in P2G4_RESP_PAYLOAD_CHUNKED mode
+ * (see p2G4_dev_rx_get_progress_*())
+ */
+typedef struct {
+  /* Bytes of the packet already in the reception buffer */
+  uint16_t received;
+  /* Offset of the first byte of the first chunk with bit errors (UINT16_MAX if none) */
+  uint16_t first_error;
+  /* Last chunk received (size 0 if none yet) */
+  p2G4_rx_chunk_t last;
+} p2G4_rx_progress_t;
+
+/*
+ * Bit error mask of the packet being/last received
+ * (see P2G4_RESP_ERROR_MASK and p2G4_dev_rx_get_error_mask_*())
+ */
+typedef struct {
+  /* Runs of bits with errors, valid until the next Rx request or mask update */
+  const p2G4_error_run_t *runs;
+  uint n_runs;
+  /* Number of bits of the packet for which errors have been calculated */
+  uint32_t calc_bits;
+  /* Absolute us when the mask was last updated */
+  bs_time_t time;
+} p2G4_rx_error_mask_t;
+
+void p2G4_rx_apply_error_mask(uint8_t *buf, size_t size, const p2G4_error_run_t *runs, uint n_runs);
+
+/*
+ * RSSI samples taken during the last reception
+ * (see P2G4_MSG_RX_RSSI_SERIES and p2G4_dev_rx_get_rssi_samples_*())
+ */
+typedef struct {
+  /* Samples, valid until the next Rx request */
+  const p2G4_rssi_power_t *samples;
+  uint n_samples;
+  /* Absolute us of the first sample, and us between samples */
+  bs_time_t start_time;
+  uint32_t period;
+} p2G4_rx_rssi_samples_t;
+
+/*
+ * Options for the next request, kept by the library until they are sent in
+ * the same frame as that request (see p2G4_dev_set_req_opt_i())
+ */
+typedef enum {
+  P2G4_REQ_OPT_ABORT_SCHED = 0,
+  P2G4_REQ_OPT_RX_FILTER,
+  P2G4_REQ_OPT_RX_ADDR_SET,
+  P2G4_REQ_OPT_RX_RSSI_SERIES,
+  P2G4_REQ_OPT_N
+} p2G4_req_opt_kind_t;
+
+typedef struct {
+  /* The option message (preceded by the device tag in multiplexed connections) */
+  uint8_t *buf;
+  /* Its size (0 = not set), and the size of buf */
+  size_t size;
+  size_t max;
+} p2G4_req_opt_t;
+
+/*
+ * Per connection transport state.
+ * Internal to libCom, devices shall not access it.
+ */
+typedef struct {
+  pb_dev_state_t *pb_dev_state;
+  /* Shared memory transport (see bs_pc_2G4_shm.h), NULL if using the FIFOs */
+  struct p2G4_shm_s *shm;
+  /* Receive buffer: [rx_start, rx_end) has been received but not yet consumed */
+  uint8_t *rx_buf;
+  size_t rx_buf_size;
+  size_t rx_start;
+  size_t rx_end;
+  p2G4_rx_pool_t rx_pool;
+  /* Multiplexed connection this device goes thru (see p2G4_mux_t), or NULL */
+  struct p2G4_mux_s *mux;
+  uint32_t mux_dev_nbr;
+  /* Last address set handle given (see p2G4_dev_addr_set_register_*()) */
+  uint32_t last_addr_set;
+  /* Bitmap of the address set handles registered and not yet released */
+  uint32_t *addr_sets_live;
+  uint32_t addr_sets_words;
+  /* Address set handle waiting for the phy registration response (0 = none) */
+  uint32_t addr_set_pending;
+  /* Request templates (see bs_pc_2G4_tmpl.c) */
+  struct p2G4_tmpl_s *tmpls;
+  uint32_t n_tmpls;
+  /* Template selected for the next request (0 = none) */
+  uint32_t next_tmpl;
+  /* Posted Tx sent since the last phy response (see P2G4_MSG_TX_POSTED_FAIL) */
+  uint32_t posted_tx;
+  /* Options for the next request */
+  p2G4_req_opt_t req_opts[P2G4_REQ_OPT_N];
+  /* A phy side Rx filter was set for the next Rx request (see P2G4_MSG_RX_FILTER) */
+  bool rx_filter_set;
+  /* The current Rx packet may come with the P2G4_MSG_RXV2_END */
+  bool rx_end_payload;
+  /* resp_type of the current/last Rx request */
+  uint8_t rx_resp_type;
+  /* Reception buffer and size of the packet being received (chunked mode) */
+  uint8_t *rx_cur_buf;
+  size_t rx_cur_size;
+  p2G4_rx_progress_t rx_progress;
+  /* Bit error mask of the current/last Rx packet (see bs_pc_2G4_err_mask.c) */
+  p2G4_error_run_t *rx_err_runs;
+  uint rx_err_n_runs;
+  uint rx_err_max_runs;
+  uint32_t rx_err_calc_bits;
+  bs_time_t rx_err_time;
+  /* RSSI samples of the last Rx (see bs_pc_2G4_rssi_series.c) */
+  p2G4_rssi_power_t *rx_rssi_samples;
+  uint rx_rssi_n;
+  uint rx_rssi_max;
+  bs_time_t rx_rssi_start;
+  uint32_t rx_rssi_period;
+} p2G4_dev_io_t;
+
 /*
  * API with call-backs and memory
  */
@@ -76,20 +227,56 @@ typedef int (*device_eval_rx_f)(p2G4_rx_done_t* rx_done, uint8_t *buff);
  */
 typedef int (*device_eval_rxv2_f)(p2G4_rxv2_done_t* rx_done, uint8_t *buff);
 
+/* Function prototype for the device to be informed of each packet received
+ * during a reception stream
+ * This function shall return 0 to continue receiving, or != 0 to end the stream
+ */
+typedef int (*device_rx_stream_packet_f)(p2G4_rxv2_done_t* rx_done, uint8_t *buff);
+
 int p2G4_dev_initcom_c(uint d, const char* s, const char* p, dev_abort_reeval_f abort_f);
 int p2G4_dev_req_rx_c_b(p2G4_rx_t *rx_s, p2G4_rx_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size, device_eval_rx_f fptr);
 int p2G4_dev_req_rxv2_c_b(p2G4_rxv2_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **buf, size_t size,
                           device_eval_rxv2_f eval_f);
 int p2G4_dev_req_rx2v1_c_b(p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **buf, size_t size,
                           device_eval_rxv2_f eval_f);
+int p2G4_dev_req_rx_stream_c_b(p2G4_rx_stream_t *rx_s, p2G4_address_t *phy_addr, p2G4_freq2_t *channels, p2G4_rxv2_done_t *rx_done_s, uint8_t **buf, size_t size,
+                               device_eval_rxv2_f eval_f, device_rx_stream_packet_f packet_f);
+int p2G4_dev_req_rx_multi_c_b(p2G4_rx_multi_t *multi_s, p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *done_s, uint8_t **rx_bufs, size_t buf_size);
+int p2G4_dev_req_rx_chain_c_b(p2G4_rx_chain_t *chain, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rx_chain_seg_t *segs,
+                              p2G4_rx_chain_done_t *done_s, uint8_t **buf, size_t size);
+int p2G4_dev_req_txrx_c_b(p2G4_txrx_t *txrx_s, p2G4_address_t *phy_addr, uint8_t *packet, p2G4_txrx_done_t *done_s,
+                          uint8_t **buf, size_t size, device_eval_rxv2_f eval_f);
+int p2G4_dev_req_rx_autoresp_c_b(p2G4_rx_autoresp_t *ar_s, p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules, uint8_t *packet,
+                                 p2G4_txrx_done_t *done_s, uint8_t **buf, size_t size, device_eval_rxv2_f eval_f);
 int p2G4_dev_req_RSSI_c_b(p2G4_rssi_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
 int p2G4_dev_req_RSSIv2_c_b(p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
+int p2G4_dev_req_rssi_sweep_c_b(p2G4_rssi_sweep_t *sweep_s, p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi);
 int p2G4_dev_req_cca_c_b(p2G4_cca_t *cca_s, p2G4_cca_done_t *cca_done_s);
 int p2G4_dev_req_ccav2_c_b(p2G4_ccav2_t *cca_s, p2G4_cca_done_t *cca_done_s);
+int p2G4_dev_req_cca_multi_c_b(p2G4_cca_multi_t *cca_s, p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s);
 int p2G4_dev_req_tx_c_b(p2G4_tx_t *tx_s, uint8_t *buf, p2G4_tx_done_t *tx_done_s);
 int p2G4_dev_req_txv2_c_b(p2G4_txv2_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
 int p2G4_dev_req_tx2v1_c_b(p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_req_tx2v1_posted_c(p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_req_tx_chain_c_b(p2G4_tx_chain_t *chain, p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s);
+int p2G4_dev_req_cca_tx_c_b(p2G4_cca_tx_t *cca_tx_s, uint32_t *backoffs, uint8_t *packet, p2G4_cca_tx_done_t *done_s);
 int p2G4_dev_req_wait_c_b(pb_wait_t *wait_s);
+int p2G4_dev_set_abort_sched_c(p2G4_abort_t *steps, uint n_steps);
+int p2G4_dev_set_rx_filter_c(p2G4_rx_filter_t *filter, p2G4_rx_filter_rule_t *rules);
+int p2G4_dev_set_rx_rssi_series_c(p2G4_rssi_series_t *series);
+int p2G4_dev_addr_set_register_c(p2G4_address_t *addr, uint32_t n_addr, uint32_t *handle);
+int p2G4_dev_addr_set_release_c(uint32_t handle);
+int p2G4_dev_set_rx_addr_set_c(uint32_t handle);
+int p2G4_dev_tmpl_register_tx2v1_c(p2G4_tx2v1_t *tx_s, uint32_t *handle);
+int p2G4_dev_tmpl_register_rx2v1_c(p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, uint32_t *handle);
+int p2G4_dev_use_tmpl_c(uint32_t handle);
+int p2G4_dev_rx_fetch_payload_c(uint16_t offset, uint16_t size, uint8_t *buf);
+void p2G4_dev_rx_get_progress_c(p2G4_rx_progress_t *progress);
+int p2G4_dev_req_imm_error_mask_c_b(uint32_t start_bit);
+void p2G4_dev_rx_get_error_mask_c(p2G4_rx_error_mask_t *mask);
+void p2G4_dev_rx_get_rssi_samples_c(p2G4_rx_rssi_samples_t *samples);
+void p2G4_dev_rx_pool_release_c(uint8_t *buf);
+void p2G4_dev_rx_pool_get_stats_c(p2G4_rx_pool_stats_t *stats);
 void p2G4_dev_disconnect_c(void);
 void p2G4_dev_terminate_c(void);
 
@@ -100,10 +287,21 @@ int p2G4_dev_initcom_nc(uint d, const char* s, const char* p);
 int p2G4_dev_req_tx_nc_b(p2G4_tx_t *tx_s, uint8_t *buf, p2G4_tx_done_t *tx_done_s);
 int p2G4_dev_req_txv2_nc_b(p2G4_txv2_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
 int p2G4_dev_req_tx2v1_nc_b(p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_req_tx2v1_posted_nc(p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_req_tx_chain_nc_b(p2G4_tx_chain_t *chain, p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s);
+int p2G4_dev_req_cca_tx_nc_b(p2G4_cca_tx_t *cca_tx_s, uint32_t *backoffs, uint8_t *packet, p2G4_cca_tx_done_t *done_s);
 int p2G4_dev_provide_new_tx_abort_nc_b(p2G4_abort_t * abort);
 int p2G4_dev_req_rx_nc_b(p2G4_rx_t *rx_s, p2G4_rx_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size);
 int p2G4_dev_req_rxv2_nc_b(p2G4_rxv2_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **buf, size_t size);
 int p2G4_dev_req_rx2v1_nc_b(p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **buf, size_t size);
+int p2G4_dev_req_rx_stream_nc_b(p2G4_rx_stream_t *rx_s, p2G4_address_t *phy_addr, p2G4_freq2_t *channels, p2G4_rxv2_done_t *rx_done_s, uint8_t **buf, size_t size);
+int p2G4_dev_rx_stream_next_nc_b(void);
+int p2G4_dev_rx_stream_stop_nc_b(void);
+int p2G4_dev_req_rx_multi_nc_b(p2G4_rx_multi_t *multi_s, p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *done_s, p2G4_rx_multi_tag_t *tag_s, uint8_t **rx_bufs, size_t buf_size);
+int p2G4_dev_rx_multi_next_nc_b(void);
+int p2G4_dev_req_rx_chain_nc_b(p2G4_rx_chain_t *chain, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rx_chain_seg_t *segs, p2G4_rx_chain_done_t *done_s, uint8_t **buf, size_t size);
+int p2G4_dev_req_txrx_nc_b(p2G4_txrx_t *txrx_s, p2G4_address_t *phy_addr, uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **buf, size_t size);
+int p2G4_dev_req_rx_autoresp_nc_b(p2G4_rx_autoresp_t *ar_s, p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules, uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **buf, size_t size);
 int p2G4_dev_rx_cont_after_addr_nc_b(bool accept);
 int p2G4_dev_rxv2_cont_after_addr_nc_b(bool accept_rx, p2G4_abort_t *abort);
 int p2G4_dev_provide_new_rx_abort_nc_b(p2G4_abort_t * abort);
@@ -111,10 +309,28 @@ int p2G4_dev_provide_new_rxv2_abort_nc_b(p2G4_abort_t * abort);
 int p2G4_dev_req_imm_RSSI_nc_b(p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
 int p2G4_dev_req_RSSI_nc_b(p2G4_rssi_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
 int p2G4_dev_req_RSSIv2_nc_b(p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
+int p2G4_dev_req_rssi_sweep_nc_b(p2G4_rssi_sweep_t *sweep_s, p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi);
 int p2G4_dev_req_wait_nc_b(pb_wait_t *wait_s);
 int p2G4_dev_req_cca_nc_b(p2G4_cca_t *cca_s, p2G4_cca_done_t *cca_done_s);
 int p2G4_dev_req_ccav2_nc_b(p2G4_ccav2_t *cca_s, p2G4_cca_done_t *cca_done_s);
+int p2G4_dev_req_cca_multi_nc_b(p2G4_cca_multi_t *cca_s, p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s);
 int p2G4_dev_provide_new_cca_abort_nc_b(p2G4_abort_t * abort);
+int p2G4_dev_set_abort_sched_nc(p2G4_abort_t *steps, uint n_steps);
+int p2G4_dev_set_rx_filter_nc(p2G4_rx_filter_t *filter, p2G4_rx_filter_rule_t *rules);
+int p2G4_dev_set_rx_rssi_series_nc(p2G4_rssi_series_t *series);
+int p2G4_dev_addr_set_register_nc(p2G4_address_t *addr, uint32_t n_addr, uint32_t *handle);
+int p2G4_dev_addr_set_release_nc(uint32_t handle);
+int p2G4_dev_set_rx_addr_set_nc(uint32_t handle);
+int p2G4_dev_tmpl_register_tx2v1_nc(p2G4_tx2v1_t *tx_s, uint32_t *handle);
+int p2G4_dev_tmpl_register_rx2v1_nc(p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, uint32_t *handle);
+int p2G4_dev_use_tmpl_nc(uint32_t handle);
+int p2G4_dev_rx_fetch_payload_nc(uint16_t offset, uint16_t size, uint8_t *buf);
+void p2G4_dev_rx_get_progress_nc(p2G4_rx_progress_t *progress);
+int p2G4_dev_req_imm_error_mask_nc_b(uint32_t start_bit);
+void p2G4_dev_rx_get_error_mask_nc(p2G4_rx_error_mask_t *mask);
+void p2G4_dev_rx_get_rssi_samples_nc(p2G4_rx_rssi_samples_t *samples);
+void p2G4_dev_rx_pool_release_nc(uint8_t *buf);
+void p2G4_dev_rx_pool_get_stats_nc(p2G4_rx_pool_stats_t *stats);
 void p2G4_dev_terminate_nc(void);
 void p2G4_dev_disconnect_nc(void);
 
@@ -122,31 +338,59 @@ void p2G4_dev_disconnect_nc(void);
  * API without call-backs and without memory
  */
 //in the communication with the device, are we in the middle of a transaction (!Nothing_2G4), and if so, what
-typedef enum { Nothing_2G4 = 0, Tx_Abort_Reeval_2G4 , Rx_Abort_Reeval_2G4 , Rx_Header_Eval_2G4, CCA_Abort_Reeval_2G4 ,  } p2G4_t_ongoing_transaction_t;
+typedef enum { Nothing_2G4 = 0, Tx_Abort_Reeval_2G4 , Rx_Abort_Reeval_2G4 , Rx_Header_Eval_2G4, CCA_Abort_Reeval_2G4 , Rx_Stream_2G4 , Rx_Multi_2G4 ,  } p2G4_t_ongoing_transaction_t;
 
 typedef struct {
   pb_dev_state_t pb_dev_state;
   p2G4_t_ongoing_transaction_t ongoing; //just as a safety check against bugy devices (only used in the version without callbacks)
   p2G4_tx_done_t   *tx_done_s;
+  p2G4_tx_chain_done_t *tx_chain_done_s;
+  p2G4_cca_tx_done_t *cca_tx_done_s;
   p2G4_rx_done_t *rx_done_s;
   p2G4_rxv2_done_t *rxv2_done_s;
+  p2G4_rx_chain_done_t *rx_chain_done_s;
+  p2G4_txrx_done_t *txrx_done_s;
   p2G4_cca_done_t *cca_done_s;
+  /* Number of cca_done_s elements of a multi-frequency CCA (0 for a normal CCA) */
+  uint cca_n_freqs;
   uint8_t **rxbuf;
   size_t bufsize;
   bool WeGotAddress;
+  /* An Rx stream (p2G4_dev_req_rx_stream_s_nc_b()) is ongoing */
+  bool rx_stream;
+  /* The phy waits for the answer to a P2G4_MSG_RX_STREAM_PACKET */
+  bool rx_stream_packet;
+  /* A multi-receiver Rx (p2G4_dev_req_rx_multi_s_nc_b()) is ongoing,
+   * with rx_multi_n receivers (and rxv2_done_s and rxbuf as arrays of that size) */
+  bool rx_multi;
+  uint rx_multi_n;
+  p2G4_rx_multi_tag_t *rx_multi_tag_s;
+  p2G4_dev_io_t io;
 } p2G4_dev_state_nc_t;
 
 int p2G4_dev_initCom_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, uint d, const char* s, const char* p);
 int p2G4_dev_req_tx_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_tx_t *tx_s, uint8_t *buf, p2G4_tx_done_t *tx_done_s);
 int p2G4_dev_req_txv2_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_txv2_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
 int p2G4_dev_req_tx2v1_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_req_tx2v1_posted_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_req_tx_chain_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_tx_chain_t *chain, p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s);
+int p2G4_dev_req_cca_tx_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_cca_tx_t *cca_tx_s, uint32_t *backoffs, uint8_t *packet, p2G4_cca_tx_done_t *done_s);
 int p2G4_dev_provide_new_tx_abort_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_abort_t * abort);
 int p2G4_dev_req_cca_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_cca_t *cca_s, p2G4_cca_done_t *cca_done_s);
 int p2G4_dev_req_ccav2_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_ccav2_t *cca_s, p2G4_cca_done_t *cca_done_s);
+int p2G4_dev_req_cca_multi_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_cca_multi_t *cca_s, p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s);
 int p2G4_dev_provide_new_cca_abort_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_abort_t * abort);
 int p2G4_dev_req_rx_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rx_t *rx_s, p2G4_rx_done_t *rx_done_s, uint8_t **rx_buf, size_t bus_size);
 int p2G4_dev_req_rxv2_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rxv2_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size);
 int p2G4_dev_req_rx2v1_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_req_rx_stream_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_stream_t *rx_s, p2G4_address_t *phy_addr, p2G4_freq2_t *channels, p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_rx_stream_next_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state);
+int p2G4_dev_rx_stream_stop_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state);
+int p2G4_dev_req_rx_multi_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_multi_t *multi_s, p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *done_s, p2G4_rx_multi_tag_t *tag_s, uint8_t **rx_bufs, size_t buf_size);
+int p2G4_dev_rx_multi_next_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state);
+int p2G4_dev_req_rx_chain_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_chain_t *chain, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rx_chain_seg_t *segs, p2G4_rx_chain_done_t *done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_req_txrx_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_txrx_t *txrx_s, p2G4_address_t *phy_addr, uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_req_rx_autoresp_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_autoresp_t *ar_s, p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules, uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **rx_buf, size_t buf_size);
 int p2G4_dev_rx_cont_after_addr_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, bool accept);
 int p2G4_dev_rxv2_cont_after_addr_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, bool dev_accepts, p2G4_abort_t * abort);
 int p2G4_dev_provide_new_rx_abort_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_abort_t * abort);
@@ -154,7 +398,24 @@ int p2G4_dev_provide_new_rxv2_abort_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state,
 int p2G4_dev_req_imm_RSSI_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssiv2_t *rssi_req, p2G4_rssi_done_t *rssi_resp);
 int p2G4_dev_req_RSSI_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssi_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
 int p2G4_dev_req_RSSIv2_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
+int p2G4_dev_req_rssi_sweep_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssi_sweep_t *sweep_s, p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi);
 int p2G4_dev_req_wait_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, pb_wait_t *wait_s);
+int p2G4_dev_set_abort_sched_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_abort_t *steps, uint n_steps);
+int p2G4_dev_set_rx_filter_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rx_filter_t *filter, p2G4_rx_filter_rule_t *rules);
+int p2G4_dev_set_rx_rssi_series_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssi_series_t *series);
+int p2G4_dev_addr_set_register_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_address_t *addr, uint32_t n_addr, uint32_t *handle);
+int p2G4_dev_addr_set_release_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, uint32_t handle);
+int p2G4_dev_set_rx_addr_set_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, uint32_t handle);
+int p2G4_dev_tmpl_register_tx2v1_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_tx2v1_t *tx_s, uint32_t *handle);
+int p2G4_dev_tmpl_register_rx2v1_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, uint32_t *handle);
+int p2G4_dev_use_tmpl_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, uint32_t handle);
+int p2G4_dev_rx_fetch_payload_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, uint16_t offset, uint16_t size, uint8_t *buf);
+void p2G4_dev_rx_get_progress_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rx_progress_t *progress);
+int p2G4_dev_req_imm_error_mask_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, uint32_t start_bit);
+void p2G4_dev_rx_get_error_mask_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rx_error_mask_t *mask);
+void p2G4_dev_rx_get_rssi_samples_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rx_rssi_samples_t *samples);
+void p2G4_dev_rx_pool_release_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, uint8_t *buf);
+void p2G4_dev_rx_pool_get_stats_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rx_pool_stats_t *stats);
 void p2G4_dev_terminate_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st);
 void p2G4_dev_disconnect_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st);
 
@@ -165,27 +426,222 @@ void p2G4_dev_disconnect_s_nc(p2G4_dev_state_nc_t *p2G4_dev_st);
 typedef struct {
   dev_abort_reeval_f abort_f;
   pb_dev_state_t pb_dev_state;
+  p2G4_dev_io_t io;
 } p2G4_dev_state_s_t;
 
 int p2G4_dev_initcom_s_c(p2G4_dev_state_s_t *p2G4_dev_st, uint d, const char* s, const char* p, dev_abort_reeval_f fptr);
 int p2G4_dev_req_tx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_tx_t *tx_s, uint8_t *buf, p2G4_tx_done_t *tx_done_s);
 int p2G4_dev_req_txv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_txv2_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
 int p2G4_dev_req_tx2v1_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_req_tx2v1_posted_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_req_tx_chain_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx_chain_t *chain, p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s);
+int p2G4_dev_req_cca_tx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_cca_tx_t *cca_tx_s, uint32_t *backoffs, uint8_t *packet, p2G4_cca_tx_done_t *done_s);
 int p2G4_dev_req_tx_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_tx_t *tx_s, uint8_t *buf);
+int p2G4_dev_req_txv2_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_txv2_t *tx_s, uint8_t *packet);
 int p2G4_dev_pick_txresp_s_c_b(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_tx_done_t *tx_done_s);
 int p2G4_dev_req_rx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rx_t *rx_s, p2G4_rx_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size, device_eval_rx_f fptr);
 int p2G4_dev_req_rxv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rxv2_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size, device_eval_rxv2_f dev_rxeval_f);
 int p2G4_dev_req_rx2v1_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size, device_eval_rxv2_f dev_rxeval_f);
+int p2G4_dev_req_rx_stream_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_stream_t *rx_s, p2G4_address_t *phy_addr, p2G4_freq2_t *channels, p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size, device_eval_rxv2_f dev_rxeval_f, device_rx_stream_packet_f packet_f);
+int p2G4_dev_req_rx_multi_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_multi_t *multi_s, p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *done_s, uint8_t **rx_bufs, size_t buf_size);
+int p2G4_dev_req_rx_chain_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_chain_t *chain, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rx_chain_seg_t *segs, p2G4_rx_chain_done_t *done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_req_txrx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_txrx_t *txrx_s, p2G4_address_t *phy_addr, uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **rx_buf, size_t buf_size, device_eval_rxv2_f dev_rxeval_f);
+int p2G4_dev_req_rx_autoresp_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_autoresp_t *ar_s, p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules, uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **rx_buf, size_t buf_size, device_eval_rxv2_f dev_rxeval_f);
 int p2G4_dev_req_RSSI_s_c_b(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rssi_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
 int p2G4_dev_req_RSSIv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
+int p2G4_dev_req_rssi_sweep_s_c_b(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rssi_sweep_t *sweep_s, p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi);
 int p2G4_dev_req_cca_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_cca_t *cca_s, p2G4_cca_done_t *cca_done_s);
 int p2G4_dev_req_ccav2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_ccav2_t *cca_s, p2G4_cca_done_t *cca_done_s);
+int p2G4_dev_req_cca_multi_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_cca_multi_t *cca_s, p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s);
 int p2G4_dev_req_wait_s_c_b(p2G4_dev_state_s_t *p2G4_dev_st, pb_wait_t *wait_s);
 int p2G4_dev_req_wait_s_c(p2G4_dev_state_s_t *p2G4_dev_st, pb_wait_t *wait_s);
 int p2G4_dev_pick_wait_resp_s_c_b(p2G4_dev_state_s_t *p2G4_dev_st);
+int p2G4_dev_set_abort_sched_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_abort_t *steps, uint n_steps);
+int p2G4_dev_set_rx_filter_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rx_filter_t *filter, p2G4_rx_filter_rule_t *rules);
+int p2G4_dev_set_rx_rssi_series_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rssi_series_t *series);
+int p2G4_dev_addr_set_register_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_address_t *addr, uint32_t n_addr, uint32_t *handle);
+int p2G4_dev_addr_set_release_s_c(p2G4_dev_state_s_t *p2G4_dev_st, uint32_t handle);
+int p2G4_dev_set_rx_addr_set_s_c(p2G4_dev_state_s_t *p2G4_dev_st, uint32_t handle);
+int p2G4_dev_tmpl_register_tx2v1_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_tx2v1_t *tx_s, uint32_t *handle);
+int p2G4_dev_tmpl_register_rx2v1_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, uint32_t *handle);
+int p2G4_dev_use_tmpl_s_c(p2G4_dev_state_s_t *p2G4_dev_st, uint32_t handle);
+int p2G4_dev_rx_fetch_payload_s_c(p2G4_dev_state_s_t *p2G4_dev_st, uint16_t offset, uint16_t size, uint8_t *buf);
+void p2G4_dev_rx_get_progress_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rx_progress_t *progress);
+int p2G4_dev_req_imm_error_mask_s_c_b(p2G4_dev_state_s_t *p2G4_dev_st, uint32_t start_bit);
+void p2G4_dev_rx_get_error_mask_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rx_error_mask_t *mask);
+void p2G4_dev_rx_get_rssi_samples_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rx_rssi_samples_t *samples);
+void p2G4_dev_rx_pool_release_s_c(p2G4_dev_state_s_t *p2G4_dev_st, uint8_t *buf);
+void p2G4_dev_rx_pool_get_stats_s_c(p2G4_dev_state_s_t *p2G4_dev_st, p2G4_rx_pool_stats_t *stats);
 void p2G4_dev_disconnect_s_c(p2G4_dev_state_s_t *p2G4_dev_st);
 void p2G4_dev_terminate_s_c(p2G4_dev_state_s_t *p2G4_dev_st);
 
+/*
+ * Asynchronous API (without call-backs and without memory) (_s_a)
+ *
+ * Requests are submitted without waiting for the phy response.
+ * Each submit returns a handle, and once the phy responds, a completion with
+ * that handle is placed in the connection completion queue, from where the
+ * device picks it with p2G4_dev_poll_s_a() (non blocking) or
+ * p2G4_dev_wait_completion_s_a_b() (blocking).
+ * Meanwhile the device is free to do other things.
+ *
+ * Abort reevaluations and address found (header evaluation) events are
+ * also delivered as completions (with done == false), after which the
+ * device shall continue the transaction with p2G4_dev_provide_new_abort_s_a()
+ * or p2G4_dev_rx_cont_after_addr_s_a().
+ *
+ * As the phy handles one transaction per device at a time, only one request
+ * may be ongoing at any given time.
+ */
+
+/* Size of the completion queue */
+#define P2G4_ASYNC_CQ_SIZE 16
+
+typedef enum {
+  P2G4_REQ_NONE = 0,
+  P2G4_REQ_TX, P2G4_REQ_TXV2, P2G4_REQ_TX2V1,
+  P2G4_REQ_RX, P2G4_REQ_RXV2, P2G4_REQ_RX2V1,
+  P2G4_REQ_RSSI, P2G4_REQ_RSSIV2, P2G4_REQ_RSSI_SWEEP,
+  P2G4_REQ_CCA, P2G4_REQ_CCAV2, P2G4_REQ_CCA_MULTI,
+  P2G4_REQ_WAIT,
+  P2G4_REQ_RX_PAYLOAD,
+  P2G4_REQ_TX_CHAIN, P2G4_REQ_RX_CHAIN,
+  P2G4_REQ_TXRX, P2G4_REQ_CCA_TX,
+  P2G4_REQ_RX_MULTI,
+} p2G4_req_type_t;
+
+typedef struct {
+  /* Handle returned when the request was submitted */
+  int handle;
+  p2G4_req_type_t type;
+  /*
+   * Phy response: P2G4_MSG_TX_END, P2G4_MSG_RX_END, P2G4_MSG_RXV2_END,
+   * P2G4_MSG_RSSI_END, P2G4_MSG_CCA_END, PB_MSG_WAIT_END, P2G4_MSG_RX_PAYLOAD,
+   * P2G4_MSG_TX_CHAIN_END, P2G4_MSG_RX_CHAIN_END, P2G4_MSG_TXRX_END,
+   * P2G4_MSG_CCA_TX_END, P2G4_MSG_RSSI_SWEEP_END, P2G4_MSG_CCA_MULTI_END,
+   * P2G4_MSG_RX_MULTI_END,
+   * P2G4_MSG_ABORTREEVAL, P2G4_MSG_RX_ADDRESSFOUND or P2G4_MSG_RXV2_ADDRESSFOUND
+   * The response structures are updated thru the pointers provided with the submit
+   */
+  pc_header_t header;
+  /* The request is over (false for abort reevaluations, address found, and
+   * for each P2G4_MSG_RX_MULTI_END but the last) */
+  bool done;
+  /* For a P2G4_MSG_RX_MULTI_END: which receiver ended, and how many are still ongoing */
+  p2G4_rx_multi_tag_t rx_multi;
+} p2G4_completion_t;
+
+/* Internal to libCom, devices shall not access it */
+typedef struct {
+  p2G4_req_type_t type;
+  int handle;
+  /* Response structure provided by the device with the submit */
+  void *done_s;
+  uint8_t **rxbuf;
+  size_t bufsize;
+  /* Destination of a P2G4_REQ_RX_PAYLOAD */
+  uint8_t *payload_buf;
+  /* Number of measurements a P2G4_REQ_RSSI_SWEEP or P2G4_REQ_CCA_MULTI
+   * done_s array holds (receivers for a P2G4_REQ_RX_MULTI) */
+  uint n_meas;
+  bool WeGotAddress;
+  /* Event (abort reevaluation or address found) the phy is waiting for the
+   * device to respond to (0 if none) */
+  pc_header_t pending_ev;
+} p2G4_async_req_t;
+
+typedef struct p2G4_dev_state_a_s {
+  pb_dev_state_t pb_dev_state;
+  /* Ongoing request (if req.type != P2G4_REQ_NONE) */
+  p2G4_async_req_t req;
+  int last_handle;
+  p2G4_completion_t cq[P2G4_ASYNC_CQ_SIZE];
+  uint cq_first;
+  uint cq_count;
+  p2G4_dev_io_t io;
+} p2G4_dev_state_a_t;
+
+int p2G4_dev_initcom_s_a(p2G4_dev_state_a_t *p2G4_dev_st, uint d, const char* s, const char* p);
+int p2G4_dev_get_fd_s_a(p2G4_dev_state_a_t *p2G4_dev_st);
+int p2G4_dev_submit_tx_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_tx_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_submit_txv2_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_txv2_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_submit_tx2v1_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_submit_tx2v1_posted_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_submit_tx_chain_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_tx_chain_t *chain, p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s);
+int p2G4_dev_submit_cca_tx_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_cca_tx_t *cca_tx_s, uint32_t *backoffs, uint8_t *packet, p2G4_cca_tx_done_t *done_s);
+int p2G4_dev_submit_rx_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_t *rx_s, p2G4_rx_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_submit_rxv2_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rxv2_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_submit_rx2v1_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_submit_rx_chain_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_chain_t *chain, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, p2G4_rx_chain_seg_t *segs, p2G4_rx_chain_done_t *done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_submit_rx_multi_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_multi_t *multi_s, p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr, p2G4_rxv2_done_t *done_s, uint8_t **rx_bufs, size_t buf_size);
+int p2G4_dev_submit_txrx_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_txrx_t *txrx_s, p2G4_address_t *phy_addr, uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_submit_rx_autoresp_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_autoresp_t *ar_s, p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules, uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_submit_RSSI_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rssi_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
+int p2G4_dev_submit_RSSIv2_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s);
+int p2G4_dev_submit_rssi_sweep_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rssi_sweep_t *sweep_s, p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi);
+int p2G4_dev_submit_cca_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_cca_t *cca_s, p2G4_cca_done_t *cca_done_s);
+int p2G4_dev_submit_ccav2_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_ccav2_t *cca_s, p2G4_cca_done_t *cca_done_s);
+int p2G4_dev_submit_cca_multi_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_cca_multi_t *cca_s, p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s);
+int p2G4_dev_submit_wait_s_a(p2G4_dev_state_a_t *p2G4_dev_st, pb_wait_t *wait_s);
+int p2G4_dev_submit_rx_fetch_payload_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_payload_t *pl, uint8_t *buf);
+int p2G4_dev_provide_new_abort_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_abort_t *abort);
+int p2G4_dev_rx_cont_after_addr_s_a(p2G4_dev_state_a_t *p2G4_dev_st, bool dev_accepts, p2G4_abort_t *abort);
+int p2G4_dev_poll_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_completion_t *completion);
+int p2G4_dev_wait_completion_s_a_b(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_completion_t *completion);
+int p2G4_dev_set_abort_sched_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_abort_t *steps, uint n_steps);
+int p2G4_dev_set_rx_filter_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_filter_t *filter, p2G4_rx_filter_rule_t *rules);
+int p2G4_dev_set_rx_rssi_series_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rssi_series_t *series);
+int p2G4_dev_addr_set_register_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_address_t *addr, uint32_t n_addr, uint32_t *handle);
+int p2G4_dev_addr_set_release_s_a(p2G4_dev_state_a_t *p2G4_dev_st, uint32_t handle);
+int p2G4_dev_set_rx_addr_set_s_a(p2G4_dev_state_a_t *p2G4_dev_st, uint32_t handle);
+int p2G4_dev_tmpl_register_tx2v1_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_tx2v1_t *tx_s, uint32_t *handle);
+int p2G4_dev_tmpl_register_rx2v1_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr, uint32_t *handle);
+int p2G4_dev_use_tmpl_s_a(p2G4_dev_state_a_t *p2G4_dev_st, uint32_t handle);
+void p2G4_dev_rx_get_progress_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_progress_t *progress);
+void p2G4_dev_rx_get_error_mask_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_error_mask_t *mask);
+void p2G4_dev_rx_get_rssi_samples_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_rssi_samples_t *samples);
+void p2G4_dev_rx_pool_release_s_a(p2G4_dev_state_a_t *p2G4_dev_st, uint8_t *buf);
+void p2G4_dev_rx_pool_get_stats_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_rx_pool_stats_t *stats);
+void p2G4_dev_disconnect_s_a(p2G4_dev_state_a_t *p2G4_dev_st);
+void p2G4_dev_terminate_s_a(p2G4_dev_state_a_t *p2G4_dev_st);
+
+/*
+ * Multiplexed connections
+ *
+ * One connection (FIFO pair or shared memory) to the phy may carry the
+ * messages of several devices, so one host process can run many device
+ * models without one process and FIFO pair per device.
+ * The phy still sees them as separate devices.
+ *
+ * The host opens the connection with p2G4_mux_initcom(), with the list of
+ * device numbers it will run, and then binds a p2G4_dev_state_a_t to each of
+ * them with p2G4_dev_initcom_mux_s_a(). From there on, each device is used
+ * thru the asynchronous API (_s_a), as if it had its own connection.
+ *
+ * p2G4_mux_poll() and p2G4_mux_wait_b() read the next phy response
+ * (for whichever device) and queue its completion in that device.
+ * p2G4_dev_poll_s_a() and p2G4_dev_wait_completion_s_a_b() on a multiplexed
+ * device also do this as needed, which may queue completions in the other
+ * devices of the connection. As the connection reads ahead, the host shall
+ * drain p2G4_mux_poll() until it returns 0 before waiting on
+ * p2G4_mux_get_fd().
+ */
+typedef struct p2G4_mux_s {
+  pb_dev_state_t pb_dev_state;
+  p2G4_dev_io_t io;
+  /* Devices bound to this connection, indexed by device number */
+  p2G4_dev_state_a_t **devs;
+  uint n_devs;
+} p2G4_mux_t;
+
+int p2G4_mux_initcom(p2G4_mux_t *mux, const uint *dev_nbrs, uint n_devs, const char* s, const char* p);
+int p2G4_dev_initcom_mux_s_a(p2G4_dev_state_a_t *p2G4_dev_st, p2G4_mux_t *mux, uint d);
+int p2G4_mux_get_fd(p2G4_mux_t *mux);
+int p2G4_mux_pending(p2G4_mux_t *mux);
+int p2G4_mux_poll(p2G4_mux_t *mux, p2G4_dev_state_a_t **dev);
+int p2G4_mux_wait_b(p2G4_mux_t *mux, p2G4_dev_state_a_t **dev);
+void p2G4_mux_disconnect(p2G4_mux_t *mux);
+
 #ifdef __cplusplus
 }
 #endif
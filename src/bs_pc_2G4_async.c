@@ -0,0 +1,1035 @@
+/*
+ * Copyright 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Asynchronous (submit/complete) API (_s_a)
+ *
+ * See bs_pc_2G4.h for a description
+ */
+
+#include <string.h>
+#include "bs_tracing.h"
+#include "bs_pc_2G4_types.h"
+#include "bs_pc_2G4.h"
+#include "bs_pc_2G4_priv.h"
+
+static void p2G4_async_init(p2G4_dev_state_a_t *p2G4_dev_state) {
+  memset(&p2G4_dev_state->req, 0, sizeof(p2G4_async_req_t));
+  p2G4_dev_state->last_handle = 0;
+  p2G4_dev_state->cq_first = 0;
+  p2G4_dev_state->cq_count = 0;
+}
+
+int p2G4_dev_initcom_s_a(p2G4_dev_state_a_t *p2G4_dev_state, uint d,
+                         const char* s, const char* p) {
+  p2G4_async_init(p2G4_dev_state);
+  return p2G4_dev_init_com_i(&p2G4_dev_state->io, &p2G4_dev_state->pb_dev_state, d, s, p);
+}
+
+/**
+ * Bind this device state to device number <d> of the multiplexed
+ * connection <mux> (see p2G4_mux_initcom())
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_initcom_mux_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_mux_t *mux, uint d) {
+  CHECK_CONNECTED(mux->pb_dev_state.connected);
+
+  if ((d >= mux->n_devs) || (mux->devs[d] != NULL)) {
+    bs_trace_error_line("Device %u is not part of this multiplexed connection, or it is already bound\n", d);
+  }
+  p2G4_async_init(p2G4_dev_state);
+  p2G4_dev_init_mux_i(&p2G4_dev_state->io, &p2G4_dev_state->pb_dev_state, mux, d);
+  mux->devs[d] = p2G4_dev_state;
+  return 0;
+}
+
+void p2G4_dev_terminate_s_a(p2G4_dev_state_a_t *p2G4_dev_state){
+  p2G4_dev_terminate_i(&p2G4_dev_state->io);
+}
+
+void p2G4_dev_disconnect_s_a(p2G4_dev_state_a_t *p2G4_dev_state){
+  p2G4_dev_disconnect_i(&p2G4_dev_state->io);
+}
+
+/**
+ * File descriptor which becomes readable when the phy responds, so the device
+ * can wait for completions (of this and other connections) with
+ * poll/select/epoll.
+ * Note that responses may already have been read into the connection buffers,
+ * so before waiting on the fd, the device shall call p2G4_dev_poll_s_a()
+ * until it returns 0.
+ *
+ * Returns -1 if there is no such fd (not connected, or using the shared
+ * memory transport, in which case the device shall just poll)
+ */
+int p2G4_dev_get_fd_s_a(p2G4_dev_state_a_t *p2G4_dev_state){
+  return p2G4_dev_get_fd_i(&p2G4_dev_state->io);
+}
+
+static void p2G4_cq_push(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_completion_t *completion){
+  uint idx;
+
+  if (p2G4_dev_state->cq_count >= P2G4_ASYNC_CQ_SIZE) {
+    bs_trace_error_time_line("Completion queue overflow (the device is not picking its completions)\n");
+  }
+  idx = (p2G4_dev_state->cq_first + p2G4_dev_state->cq_count) % P2G4_ASYNC_CQ_SIZE;
+  p2G4_dev_state->cq[idx] = *completion;
+  p2G4_dev_state->cq_count++;
+}
+
+static int p2G4_cq_pop(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_completion_t *completion){
+  if (p2G4_dev_state->cq_count == 0) {
+    return 0;
+  }
+  *completion = p2G4_dev_state->cq[p2G4_dev_state->cq_first];
+  p2G4_dev_state->cq_first = (p2G4_dev_state->cq_first + 1) % P2G4_ASYNC_CQ_SIZE;
+  p2G4_dev_state->cq_count--;
+  return 1;
+}
+
+/*
+ * Register a new ongoing request, and return its handle
+ */
+static int p2G4_async_start(p2G4_dev_state_a_t *p2G4_dev_state,
+                            p2G4_req_type_t type, void *done_s){
+  p2G4_async_req_t *req = &p2G4_dev_state->req;
+
+  if (req->type != P2G4_REQ_NONE) {
+    bs_trace_error_time_line("Tried to submit a new request while another one was ongoing\n");
+  }
+  p2G4_dev_state->last_handle++;
+  if (p2G4_dev_state->last_handle <= 0) {
+    p2G4_dev_state->last_handle = 1;
+  }
+  req->type = type;
+  req->handle = p2G4_dev_state->last_handle;
+  req->done_s = done_s;
+  req->rxbuf = NULL;
+  req->bufsize = 0;
+  req->payload_buf = NULL;
+  req->WeGotAddress = false;
+  req->pending_ev = 0;
+  return req->handle;
+}
+
+static int p2G4_async_handle_rx_resp(p2G4_dev_state_a_t *p2G4_dev_state,
+                                     pc_header_t header, p2G4_completion_t *completion){
+  p2G4_async_req_t *req = &p2G4_dev_state->req;
+  pc_header_t addr_found_header, end_header;
+  size_t done_size, packet_size;
+  void *rx_done_s = req->done_s;
+
+  if (req->type == P2G4_REQ_RX) {
+    addr_found_header = P2G4_MSG_RX_ADDRESSFOUND;
+    end_header = P2G4_MSG_RX_END;
+    done_size = sizeof(p2G4_rx_done_t);
+  } else if (req->type == P2G4_REQ_TXRX) {
+    addr_found_header = P2G4_MSG_RXV2_ADDRESSFOUND;
+    end_header = P2G4_MSG_TXRX_END;
+    done_size = sizeof(p2G4_rxv2_done_t);
+    rx_done_s = &((p2G4_txrx_done_t *)req->done_s)->rx;
+  } else {
+    addr_found_header = P2G4_MSG_RXV2_ADDRESSFOUND;
+    end_header = P2G4_MSG_RXV2_END;
+    done_size = sizeof(p2G4_rxv2_done_t);
+  }
+
+  if (header == P2G4_MSG_ABORTREEVAL) {
+    completion->done = false;
+  } else if ((header == addr_found_header) && (req->WeGotAddress == false)) {
+    if (p2G4_dev_read_i(&p2G4_dev_state->io, rx_done_s, done_size) == -1) {
+      return -1;
+    }
+    if (req->type == P2G4_REQ_RX) {
+      packet_size = ((p2G4_rx_done_t *)rx_done_s)->packet_size;
+    } else {
+      packet_size = ((p2G4_rxv2_done_t *)rx_done_s)->packet_size;
+    }
+    if (p2G4_rx_pick_packet(&p2G4_dev_state->io, packet_size,
+                            req->rxbuf, req->bufsize) == -1) {
+      return -1;
+    }
+    req->WeGotAddress = true;
+    completion->done = false;
+  } else if (header == end_header) {
+    if (req->type == P2G4_REQ_RX) {
+      if (p2G4_dev_read_i(&p2G4_dev_state->io, req->done_s, done_size) == -1) {
+        return -1;
+      }
+    } else if (req->type == P2G4_REQ_TXRX) {
+      if (p2G4_dev_read_txrx_end_i(&p2G4_dev_state->io, req->done_s,
+                                   req->WeGotAddress, req->rxbuf, req->bufsize) == -1) {
+        return -1;
+      }
+    } else if (p2G4_dev_read_rxv2_end_i(&p2G4_dev_state->io, req->done_s,
+                                        req->WeGotAddress, req->rxbuf, req->bufsize) == -1) {
+      return -1;
+    }
+  } else {
+    INVALID_RESP(header);
+    return -1;
+  }
+  return 0;
+}
+
+/*
+ * Handle a response from the phy to the ongoing request, and queue its completion
+ *
+ * returns -1 on error (and we will be disconnected), 0 otherwise
+ */
+static int p2G4_async_handle_resp(p2G4_dev_state_a_t *p2G4_dev_state, pc_header_t header){
+  p2G4_async_req_t *req = &p2G4_dev_state->req;
+  p2G4_completion_t completion;
+  int ret = 0;
+
+  if (header == PB_MSG_DISCONNECT) {
+    req->type = P2G4_REQ_NONE;
+    p2G4_dev_clean_up_i(&p2G4_dev_state->io);
+    return -1;
+  }
+  if ((header == P2G4_MSG_ADDR_SET_ACK) || (header == P2G4_MSG_ADDR_SET_NACK)) {
+    /* Response to an address set registration, not to the ongoing request */
+    return p2G4_dev_handle_addr_set_resp_i(&p2G4_dev_state->io, header);
+  }
+  if (header == P2G4_MSG_RX_CHUNK) {
+    /* Just progress on the ongoing reception, there is no completion for it */
+    if (p2G4_dev_handle_rx_chunk_i(&p2G4_dev_state->io) == -1) {
+      req->type = P2G4_REQ_NONE;
+      return -1;
+    }
+    return 0;
+  }
+  if (header == P2G4_MSG_RX_ERROR_MASK) {
+    /* The error mask sent before the reception ends, no completion either */
+    if (p2G4_dev_handle_rx_error_mask_i(&p2G4_dev_state->io) == -1) {
+      req->type = P2G4_REQ_NONE;
+      return -1;
+    }
+    return 0;
+  }
+  if (header == P2G4_MSG_RX_RSSI_SAMPLES) {
+    /* Also sent before the reception ends, without completion */
+    if (p2G4_dev_handle_rx_rssi_samples_i(&p2G4_dev_state->io) == -1) {
+      req->type = P2G4_REQ_NONE;
+      return -1;
+    }
+    return 0;
+  }
+  if (header == P2G4_MSG_TX_POSTED_FAIL) {
+    /* The completion of that posted Tx was already given, we can only disconnect */
+    req->type = P2G4_REQ_NONE;
+    return p2G4_dev_handle_tx_posted_fail_i(&p2G4_dev_state->io);
+  }
+  p2G4_dev_state->io.posted_tx = 0;
+
+  completion.handle = req->handle;
+  completion.type = req->type;
+  completion.header = header;
+  completion.done = true;
+  memset(&completion.rx_multi, 0, sizeof(p2G4_rx_multi_tag_t));
+
+  switch (req->type) {
+  case P2G4_REQ_TX:
+  case P2G4_REQ_TXV2:
+  case P2G4_REQ_TX2V1:
+    if (header == P2G4_MSG_ABORTREEVAL) {
+      completion.done = false;
+    } else {
+      ret = p2G4_dev_handle_tx_resp_i(&p2G4_dev_state->io, header, req->done_s);
+    }
+    break;
+  case P2G4_REQ_TX_CHAIN:
+    if (header == P2G4_MSG_ABORTREEVAL) {
+      completion.done = false;
+    } else {
+      ret = p2G4_dev_handle_tx_chain_resp_i(&p2G4_dev_state->io, header, req->done_s);
+    }
+    break;
+  case P2G4_REQ_CCA_TX:
+    if (header == P2G4_MSG_ABORTREEVAL) {
+      completion.done = false;
+    } else {
+      ret = p2G4_dev_handle_cca_tx_resp_i(&p2G4_dev_state->io, header, req->done_s);
+    }
+    break;
+  case P2G4_REQ_CCA:
+  case P2G4_REQ_CCAV2:
+    if (header == P2G4_MSG_ABORTREEVAL) {
+      completion.done = false;
+    } else {
+      ret = p2G4_dev_handle_cca_resp_i(&p2G4_dev_state->io, header, req->done_s);
+    }
+    break;
+  case P2G4_REQ_CCA_MULTI:
+    if (header == P2G4_MSG_ABORTREEVAL) {
+      completion.done = false;
+    } else {
+      ret = p2G4_dev_handle_cca_multi_resp_i(&p2G4_dev_state->io, header, req->done_s,
+                                             req->n_meas);
+    }
+    break;
+  case P2G4_REQ_RSSI:
+  case P2G4_REQ_RSSIV2:
+    ret = p2G4_dev_handle_rssi_resp_i(&p2G4_dev_state->io, header, req->done_s);
+    break;
+  case P2G4_REQ_RSSI_SWEEP:
+    ret = p2G4_dev_handle_rssi_sweep_resp_i(&p2G4_dev_state->io, header, req->done_s,
+                                            req->n_meas);
+    break;
+  case P2G4_REQ_RX:
+  case P2G4_REQ_RXV2:
+  case P2G4_REQ_RX2V1:
+  case P2G4_REQ_TXRX:
+    ret = p2G4_async_handle_rx_resp(p2G4_dev_state, header, &completion);
+    break;
+  case P2G4_REQ_RX_CHAIN:
+    if (header == P2G4_MSG_ABORTREEVAL) {
+      completion.done = false;
+    } else {
+      ret = p2G4_dev_handle_rx_chain_resp_i(&p2G4_dev_state->io, header, req->done_s,
+                                            req->rxbuf, req->bufsize);
+    }
+    break;
+  case P2G4_REQ_RX_MULTI:
+    if (header == P2G4_MSG_ABORTREEVAL) {
+      completion.done = false;
+    } else {
+      ret = p2G4_dev_handle_rx_multi_resp_i(&p2G4_dev_state->io, header, &completion.rx_multi,
+                                            req->done_s, req->n_meas, req->rxbuf, req->bufsize);
+      completion.done = (completion.rx_multi.n_left == 0);
+    }
+    break;
+  case P2G4_REQ_RX_PAYLOAD:
+    ret = p2G4_dev_handle_rx_payload_resp_i(&p2G4_dev_state->io, header,
+                                            req->done_s, req->payload_buf);
+    break;
+  case P2G4_REQ_WAIT:
+    if (header != PB_MSG_WAIT_END) {
+      INVALID_RESP(header);
+      ret = -1;
+    }
+    break;
+  default:
+    INVALID_RESP(header);
+    ret = -1;
+    break;
+  }
+
+  if (ret == -1) {
+    req->type = P2G4_REQ_NONE;
+    return -1;
+  }
+
+  if (completion.done) {
+    req->type = P2G4_REQ_NONE;
+  } else if (header != P2G4_MSG_RX_MULTI_END) {
+    /* (The phy does not wait for the device after one receiver ends) */
+    req->pending_ev = header;
+  }
+  p2G4_cq_push(p2G4_dev_state, &completion);
+  return 0;
+}
+
+/**
+ * Block until the next phy response to the ongoing request, and handle it
+ *
+ * returns -1 on error (and we will be disconnected), 0 otherwise
+ */
+int p2G4_dev_async_pick_resp_i(p2G4_dev_state_a_t *p2G4_dev_state){
+  pc_header_t header;
+
+  if (p2G4_dev_read_i(&p2G4_dev_state->io, &header, sizeof(header)) == -1) {
+    return -1;
+  }
+  return p2G4_async_handle_resp(p2G4_dev_state, header);
+}
+
+/**
+ * Submit a transmission (v1) request to the phy
+ *
+ * tx_done_s needs to point to an allocated structure, which will be updated
+ * before the completion is queued. The packet may be reused as soon as this
+ * function returns.
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_tx_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_tx_t *tx_s,
+                           uint8_t *packet, p2G4_tx_done_t *tx_done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_TX, tx_done_s);
+  p2G4_dev_req_tx_i(&p2G4_dev_state->io, tx_s, packet);
+  return handle;
+}
+
+/**
+ * Submit a transmission (v2) request to the phy
+ * (see p2G4_dev_submit_tx_s_a())
+ */
+int p2G4_dev_submit_txv2_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_txv2_t *tx_s,
+                             uint8_t *packet, p2G4_tx_done_t *tx_done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_TXV2, tx_done_s);
+  p2G4_dev_req_txv2_i(&p2G4_dev_state->io, tx_s, packet);
+  return handle;
+}
+
+/**
+ * Submit a transmission (v2.1) request to the phy
+ * (see p2G4_dev_submit_tx_s_a())
+ */
+int p2G4_dev_submit_tx2v1_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_tx2v1_t *tx_s,
+                              uint8_t *packet, p2G4_tx_done_t *tx_done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_TX2V1, tx_done_s);
+  p2G4_dev_req_tx2v1_i(&p2G4_dev_state->io, tx_s, packet);
+  return handle;
+}
+
+/**
+ * Submit a transmission (v2.1) request to the phy, for which the phy will
+ * not respond ("posted" Tx)
+ *
+ * If the transmission cannot be aborted (abort_time and recheck_time are
+ * TIME_NEVER), tx_done_s is filled right away, and its completion is
+ * queued immediately, so the device may submit its next request right away.
+ * Otherwise this behaves just like p2G4_dev_submit_tx2v1_s_a()
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_tx2v1_posted_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_tx2v1_t *tx_s,
+                                     uint8_t *packet, p2G4_tx_done_t *tx_done_s){
+  p2G4_completion_t completion;
+
+  if (!p2G4_dev_tx2v1_postable_i(tx_s)) {
+    return p2G4_dev_submit_tx2v1_s_a(p2G4_dev_state, tx_s, packet, tx_done_s);
+  }
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  memset(&completion, 0, sizeof(p2G4_completion_t));
+  completion.handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_TX2V1, tx_done_s);
+  p2G4_dev_req_tx2v1_posted_i(&p2G4_dev_state->io, tx_s, packet, tx_done_s);
+
+  p2G4_dev_state->req.type = P2G4_REQ_NONE;
+  completion.type = P2G4_REQ_TX2V1;
+  completion.header = P2G4_MSG_TX_END;
+  completion.done = true;
+  p2G4_cq_push(p2G4_dev_state, &completion);
+  return completion.handle;
+}
+
+/**
+ * Submit a chained transmission request to the phy
+ * (see p2G4_dev_req_tx_chain_s_nc_b())
+ */
+int p2G4_dev_submit_tx_chain_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_tx_chain_t *chain,
+                                 p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_TX_CHAIN, done_s);
+  p2G4_dev_req_tx_chain_i(&p2G4_dev_state->io, chain, segs, packet);
+  return handle;
+}
+
+/**
+ * Submit a CCA followed by a conditional transmission request to the phy
+ * (see p2G4_dev_req_cca_tx_s_nc_b())
+ */
+int p2G4_dev_submit_cca_tx_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_cca_tx_t *cca_tx_s,
+                               uint32_t *backoffs, uint8_t *packet, p2G4_cca_tx_done_t *done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_CCA_TX, done_s);
+  p2G4_dev_req_cca_tx_i(&p2G4_dev_state->io, cca_tx_s, backoffs, packet);
+  return handle;
+}
+
+/**
+ * Submit a reception (v1) request to the phy
+ *
+ * rx_done_s needs to point to an allocated structure, which will be updated
+ * before the address found and end completions are queued.
+ * rx_buf and buf_size have the same meaning as for p2G4_dev_req_rx_s_nc_b()
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_rx_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx_t *rx_s,
+                           p2G4_rx_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_RX, rx_done_s);
+  p2G4_dev_state->req.rxbuf = rx_buf;
+  p2G4_dev_state->req.bufsize = buf_size;
+  p2G4_dev_req_rx_i(&p2G4_dev_state->io, rx_s);
+  return handle;
+}
+
+/**
+ * Submit a reception (v2) request to the phy
+ * (see p2G4_dev_submit_rx_s_a())
+ */
+int p2G4_dev_submit_rxv2_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rxv2_t *rx_s,
+                             p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s,
+                             uint8_t **rx_buf, size_t buf_size){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_RXV2, rx_done_s);
+  p2G4_dev_state->req.rxbuf = rx_buf;
+  p2G4_dev_state->req.bufsize = buf_size;
+  p2G4_dev_req_rxv2_i(&p2G4_dev_state->io, rx_s, phy_addr);
+  return handle;
+}
+
+/**
+ * Submit a reception (v2.1) request to the phy
+ * (see p2G4_dev_submit_rx_s_a())
+ */
+int p2G4_dev_submit_rx2v1_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx2v1_t *rx_s,
+                              p2G4_address_t *phy_addr, p2G4_rxv2_done_t *rx_done_s,
+                              uint8_t **rx_buf, size_t buf_size){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_RX2V1, rx_done_s);
+  p2G4_dev_state->req.rxbuf = rx_buf;
+  p2G4_dev_state->req.bufsize = buf_size;
+  p2G4_dev_req_rx2v1_i(&p2G4_dev_state->io, rx_s, phy_addr);
+  return handle;
+}
+
+/**
+ * Submit a chained reception request to the phy
+ * (see p2G4_dev_req_rx_chain_s_nc_b())
+ */
+int p2G4_dev_submit_rx_chain_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx_chain_t *chain,
+                                 p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr,
+                                 p2G4_rx_chain_seg_t *segs, p2G4_rx_chain_done_t *done_s,
+                                 uint8_t **rx_buf, size_t buf_size){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_RX_CHAIN, done_s);
+  p2G4_dev_state->req.rxbuf = rx_buf;
+  p2G4_dev_state->req.bufsize = buf_size;
+  p2G4_dev_req_rx_chain_i(&p2G4_dev_state->io, chain, rx_s, phy_addr, segs);
+  return handle;
+}
+
+/**
+ * Submit a reception with several receivers at the same time to the phy
+ * (see p2G4_dev_req_rx_multi_s_nc_b())
+ *
+ * There is one P2G4_MSG_RX_MULTI_END completion per receiver, as each ends,
+ * with completion.rx_multi telling which one. Only the last one is done
+ */
+int p2G4_dev_submit_rx_multi_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx_multi_t *multi_s,
+                                 p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr,
+                                 p2G4_rxv2_done_t *done_s, uint8_t **rx_bufs, size_t buf_size){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_RX_MULTI, done_s);
+  p2G4_dev_state->req.rxbuf = rx_bufs;
+  p2G4_dev_state->req.bufsize = buf_size;
+  p2G4_dev_state->req.n_meas = multi_s->n_rx;
+  p2G4_dev_req_rx_multi_i(&p2G4_dev_state->io, multi_s, rxs, phy_addr);
+  return handle;
+}
+
+/**
+ * Submit a transmission followed by a reception request to the phy
+ * (see p2G4_dev_req_txrx_s_nc_b())
+ * Its completions are as for p2G4_dev_submit_rx2v1_s_a(), but the last one
+ * has header P2G4_MSG_TXRX_END
+ */
+int p2G4_dev_submit_txrx_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_txrx_t *txrx_s,
+                             p2G4_address_t *phy_addr, uint8_t *packet,
+                             p2G4_txrx_done_t *done_s, uint8_t **rx_buf, size_t buf_size){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_TXRX, done_s);
+  p2G4_dev_state->req.rxbuf = rx_buf;
+  p2G4_dev_state->req.bufsize = buf_size;
+  p2G4_dev_req_txrx_i(&p2G4_dev_state->io, txrx_s, phy_addr, packet);
+  p2G4_dev_txrx_tx_done_i(txrx_s, done_s);
+  return handle;
+}
+
+/**
+ * Submit a reception followed by an automatic response transmission request to
+ * the phy (see p2G4_dev_req_rx_autoresp_s_nc_b())
+ * Its completions are as for p2G4_dev_submit_txrx_s_a()
+ */
+int p2G4_dev_submit_rx_autoresp_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx_autoresp_t *ar_s,
+                                    p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules,
+                                    uint8_t *packet, p2G4_txrx_done_t *done_s,
+                                    uint8_t **rx_buf, size_t buf_size){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_TXRX, done_s);
+  p2G4_dev_state->req.rxbuf = rx_buf;
+  p2G4_dev_state->req.bufsize = buf_size;
+  p2G4_dev_req_rx_autoresp_i(&p2G4_dev_state->io, ar_s, phy_addr, rules, packet);
+  p2G4_dev_rx_autoresp_tx_done_i(done_s);
+  return handle;
+}
+
+/**
+ * Submit a RSSI measurement request to the phy
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_RSSI_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rssi_t *RSSI_s,
+                             p2G4_rssi_done_t *RSSI_done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_RSSI, RSSI_done_s);
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_RSSIMEAS,
+                      (void *)RSSI_s, sizeof(p2G4_rssi_t));
+  return handle;
+}
+
+/**
+ * Submit a RSSIv2 measurement request to the phy
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_RSSIv2_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rssiv2_t *RSSI_s,
+                               p2G4_rssi_done_t *RSSI_done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_RSSIV2, RSSI_done_s);
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_RSSIV2MEAS,
+                      (void *)RSSI_s, sizeof(p2G4_rssiv2_t));
+  return handle;
+}
+
+/**
+ * Submit a sweep of RSSI measurements request to the phy
+ * (see p2G4_dev_req_rssi_sweep_s_nc_b())
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_rssi_sweep_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rssi_sweep_t *sweep_s,
+                                   p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_RSSI_SWEEP, rssi);
+  p2G4_dev_state->req.n_meas = sweep_s->n_points;
+  p2G4_dev_req_rssi_sweep_i(&p2G4_dev_state->io, sweep_s, freqs);
+  return handle;
+}
+
+/**
+ * Submit a CCA measurement request to the phy
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_cca_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_cca_t *cca_s,
+                            p2G4_cca_done_t *cca_done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_CCA, cca_done_s);
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_CCA_MEAS,
+                      (void *)cca_s, sizeof(p2G4_cca_t));
+  return handle;
+}
+
+/**
+ * Submit a CCAv2 measurement request to the phy
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_ccav2_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_ccav2_t *cca_s,
+                              p2G4_cca_done_t *cca_done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_CCAV2, cca_done_s);
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_CCAV2_MEAS,
+                      (void *)cca_s, sizeof(p2G4_ccav2_t));
+  return handle;
+}
+
+/**
+ * Submit a CCA over several frequencies request to the phy
+ * (see p2G4_dev_req_cca_multi_s_nc_b())
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_cca_multi_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_cca_multi_t *cca_s,
+                                  p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_CCA_MULTI, cca_done_s);
+  p2G4_dev_state->req.n_meas = cca_s->n_freqs;
+  p2G4_dev_req_cca_multi_i(&p2G4_dev_state->io, cca_s, freqs);
+  return handle;
+}
+
+/**
+ * Submit a wait request to the phy
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_wait_s_a(p2G4_dev_state_a_t *p2G4_dev_state, pb_wait_t *wait_s){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_WAIT, NULL);
+  p2G4_dev_req_wait_i(&p2G4_dev_state->io, wait_s);
+  return handle;
+}
+
+/**
+ * Submit a request to fetch part of the payload of the last received packet
+ * (see P2G4_RESP_PAYLOAD_*), after its reception completed
+ *
+ * pl->offset and pl->size select which part. On completion pl->size is
+ * updated with how many bytes were copied into buf (less than requested if
+ * the packet was shorter)
+ *
+ * returns -1 on error, the request handle (>0) otherwise
+ */
+int p2G4_dev_submit_rx_fetch_payload_s_a(p2G4_dev_state_a_t *p2G4_dev_state,
+                                         p2G4_rx_payload_t *pl, uint8_t *buf){
+  int handle;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  handle = p2G4_async_start(p2G4_dev_state, P2G4_REQ_RX_PAYLOAD, pl);
+  p2G4_dev_state->req.payload_buf = buf;
+  p2G4_dev_req_rx_payload_i(&p2G4_dev_state->io, pl);
+  return handle;
+}
+
+/**
+ * Provide the phy a new abort struct, after a P2G4_MSG_ABORTREEVAL completion
+ * (for any type of request)
+ *
+ * The transaction continues, and its next completion will come thru the queue
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_provide_new_abort_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_abort_t *abort){
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if (p2G4_dev_state->req.pending_ev != P2G4_MSG_ABORTREEVAL) {
+    bs_trace_error_time_line("Tried to send a new Abort substruct but we are not in an abort reevaluation!\n");
+  }
+  p2G4_dev_state->req.pending_ev = 0;
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_RERESP_ABORTREEVAL,
+                      (void *)abort, sizeof(p2G4_abort_t));
+  return 0;
+}
+
+/**
+ * Continue a reception after an address found completion
+ *  bool dev_accepts defines if the device accepts the packet or not
+ *  p2G4_abort_t * abort new abort parameters (only used for v2 and v2.1 receptions,
+ *                       and don't care if dev_accepts == false)
+ *
+ * If dev_accepts is false, the reception ends here, no further completion
+ * will be queued for it, and a new request may be submitted right away.
+ * Otherwise the reception continues, and its next completion will come thru the queue
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_rx_cont_after_addr_s_a(p2G4_dev_state_a_t *p2G4_dev_state, bool dev_accepts,
+                                    p2G4_abort_t *abort){
+  p2G4_async_req_t *req = &p2G4_dev_state->req;
+  pc_header_t header;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ((req->pending_ev != P2G4_MSG_RX_ADDRESSFOUND)
+      && (req->pending_ev != P2G4_MSG_RXV2_ADDRESSFOUND)) {
+    bs_trace_error_time_line("Tried to continue from an Rx Header eval, but we are not doing that now..\n");
+  }
+  req->pending_ev = 0;
+
+  if (!dev_accepts) {
+    header = P2G4_MSG_RXSTOP;
+    p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
+    req->type = P2G4_REQ_NONE;
+  } else if (req->type == P2G4_REQ_RX) {
+    header = P2G4_MSG_RXCONT;
+    p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
+  } else {
+    p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_RXV2CONT,
+                        abort, sizeof(p2G4_abort_t));
+  }
+  return 0;
+}
+
+/**
+ * Pick the next completion, without blocking
+ *
+ * Note that, to not block, a phy response is only picked once it has started
+ * to arrive (the phy sends each response at once, so the rest of it will
+ * be there shortly).
+ *
+ * returns 1 if a completion was copied into <completion>,
+ *         0 if there is none yet,
+ *        -1 on error (we are not connected anymore)
+ */
+int p2G4_dev_poll_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_completion_t *completion){
+  if (p2G4_cq_pop(p2G4_dev_state, completion)) {
+    return 1;
+  }
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ((p2G4_dev_state->req.type == P2G4_REQ_NONE)
+      || (p2G4_dev_state->req.pending_ev != 0)) {
+    return 0;
+  }
+  if (p2G4_dev_state->io.mux != NULL) {
+    p2G4_dev_state_a_t *dev;
+    int ret;
+
+    while ((ret = p2G4_mux_poll(p2G4_dev_state->io.mux, &dev)) == 1) {
+      if ((dev == p2G4_dev_state) && (p2G4_dev_state->cq_count > 0)) {
+        break;
+      }
+    }
+    if (ret == 1) {
+      return p2G4_cq_pop(p2G4_dev_state, completion);
+    }
+    CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+    return ret;
+  }
+  /* Responses which do not produce a completion (Rx chunks) are just consumed */
+  while (p2G4_dev_state->cq_count == 0) {
+    if (!p2G4_dev_rx_ready_i(&p2G4_dev_state->io)) {
+      return 0;
+    }
+    if (p2G4_dev_async_pick_resp_i(p2G4_dev_state) == -1) {
+      return -1;
+    }
+  }
+  return p2G4_cq_pop(p2G4_dev_state, completion);
+}
+
+/**
+ * Block until the next completion is available, and copy it into <completion>
+ *
+ * returns -1 on error (we are not connected anymore), 0 otherwise
+ */
+int p2G4_dev_wait_completion_s_a_b(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_completion_t *completion){
+  if (p2G4_cq_pop(p2G4_dev_state, completion)) {
+    return 0;
+  }
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ((p2G4_dev_state->req.type == P2G4_REQ_NONE)
+      || (p2G4_dev_state->req.pending_ev != 0)) {
+    bs_trace_error_time_line("Tried to wait for a completion, but nothing is pending from the phy\n");
+  }
+  if (p2G4_dev_state->io.mux != NULL) {
+    p2G4_dev_state_a_t *dev;
+
+    do {
+      if (p2G4_mux_wait_b(p2G4_dev_state->io.mux, &dev) == -1) {
+        return -1;
+      }
+      CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+    } while (p2G4_dev_state->cq_count == 0);
+    p2G4_cq_pop(p2G4_dev_state, completion);
+    return 0;
+  }
+  /* Responses which do not produce a completion (Rx chunks) are just consumed */
+  while (p2G4_dev_state->cq_count == 0) {
+    if (p2G4_dev_async_pick_resp_i(p2G4_dev_state) == -1) {
+      return -1;
+    }
+  }
+  p2G4_cq_pop(p2G4_dev_state, completion);
+  return 0;
+}
+
+/**
+ * Provide the phy a schedule of abort substructures for the next Tx, Rx or
+ * CCA request, to be used, in order, each time the current recheck_time is
+ * reached, instead of asking the device.
+ * Only once all <n_steps> are used, the phy will request an abort
+ * reevaluation as usual.
+ * It is sent to the phy with the next request, which shall be a Tx, Rx or CCA.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_abort_sched_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_abort_t *steps, uint n_steps){
+  if (p2G4_dev_state->req.type != P2G4_REQ_NONE) {
+    bs_trace_error_time_line("Tried to provide an abort schedule while a request was ongoing\n");
+  }
+  return p2G4_dev_set_abort_sched_i(&p2G4_dev_state->io, steps, n_steps);
+}
+
+/**
+ * Provide the phy a header filter for the next v2/v2.1 Rx request, so it
+ * accepts or rejects packets on its own instead of asking the device.
+ * With filter->ask_device == 0, the device is only informed at the end of the
+ * reception (so its header evaluation is not used)
+ * It is sent to the phy with the next request, which shall be a v2/v2.1 Rx.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_rx_filter_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx_filter_t *filter,
+                               p2G4_rx_filter_rule_t *rules){
+  if (p2G4_dev_state->req.type != P2G4_REQ_NONE) {
+    bs_trace_error_time_line("Tried to provide an Rx filter while a request was ongoing\n");
+  }
+  return p2G4_dev_set_rx_filter_i(&p2G4_dev_state->io, filter, rules);
+}
+
+/**
+ * Request RSSI samples to be taken during the next v2/v2.1 Rx request
+ * (see p2G4_rssi_series_t). Get them with p2G4_dev_rx_get_rssi_samples_s_a()
+ * once the reception ends.
+ * It is sent to the phy with the next request, which shall be a v2/v2.1 Rx.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_rx_rssi_series_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rssi_series_t *series){
+  if (p2G4_dev_state->req.type != P2G4_REQ_NONE) {
+    bs_trace_error_time_line("Tried to provide an Rx RSSI series while a request was ongoing\n");
+  }
+  return p2G4_dev_set_rx_rssi_series_i(&p2G4_dev_state->io, series);
+}
+
+/**
+ * Register in the phy a set of <n_addr> addresses (which may be more than
+ * P2G4_RXV2_MAX_ADDRESSES) to be used by later Rx requests,
+ * (see p2G4_dev_set_rx_addr_set_s_a())
+ * It blocks until the phy accepts it, after which *handle is set to the set
+ * handle. In a multiplexed connection, responses to other devices requests
+ * which arrive meanwhile are dispatched as by p2G4_mux_wait_b()
+ *
+ * returns -1 on error or if the phy rejected the set, 0 otherwise
+ */
+int p2G4_dev_addr_set_register_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_address_t *addr,
+                                   uint32_t n_addr, uint32_t *handle){
+  if (p2G4_dev_state->req.type != P2G4_REQ_NONE) {
+    bs_trace_error_time_line("Tried to register an address set while a request was ongoing\n");
+  }
+  return p2G4_dev_addr_set_register_i(&p2G4_dev_state->io, addr, n_addr, handle);
+}
+
+/**
+ * Release an address set registered with p2G4_dev_addr_set_register_s_a()
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_addr_set_release_s_a(p2G4_dev_state_a_t *p2G4_dev_state, uint32_t handle){
+  return p2G4_dev_addr_set_release_i(&p2G4_dev_state->io, handle);
+}
+
+/**
+ * Make the next v2/v2.1 Rx request also match the addresses in the registered
+ * set <handle> (besides the addresses in the request itself)
+ * It is sent to the phy with the next request, which shall be a v2/v2.1 Rx.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_rx_addr_set_s_a(p2G4_dev_state_a_t *p2G4_dev_state, uint32_t handle){
+  if (p2G4_dev_state->req.type != P2G4_REQ_NONE) {
+    bs_trace_error_time_line("Tried to select an address set while a request was ongoing\n");
+  }
+  return p2G4_dev_set_rx_addr_set_i(&p2G4_dev_state->io, handle);
+}
+
+/**
+ * Register a base Tx (v2.1) request, to be used as template for later
+ * requests (see p2G4_dev_use_tmpl_s_a())
+ * *handle is set to the template handle
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_tmpl_register_tx2v1_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_tx2v1_t *tx_s,
+                                     uint32_t *handle){
+  return p2G4_dev_tmpl_register_i(&p2G4_dev_state->io, P2G4_MSG_TX2V1, tx_s, NULL, handle);
+}
+
+/**
+ * Register a base Rx (v2.1) request (and its addresses), to be used as
+ * template for later requests (see p2G4_dev_use_tmpl_s_a())
+ * *handle is set to the template handle
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_tmpl_register_rx2v1_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx2v1_t *rx_s,
+                                     p2G4_address_t *phy_addr, uint32_t *handle){
+  return p2G4_dev_tmpl_register_i(&p2G4_dev_state->io, P2G4_MSG_RX2V1, rx_s, phy_addr, handle);
+}
+
+/**
+ * Send the next Tx or Rx (v2.1) request based on the template <handle>:
+ * If the request only differs from the template in its start time, center
+ * frequency and/or abort, only those are sent to the phy. Otherwise the
+ * request is sent in full, as usual.
+ * Shall be called right before the request it applies to.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_use_tmpl_s_a(p2G4_dev_state_a_t *p2G4_dev_state, uint32_t handle){
+  if (p2G4_dev_state->req.type != P2G4_REQ_NONE) {
+    bs_trace_error_time_line("Tried to select a template while a request was ongoing\n");
+  }
+  return p2G4_dev_use_tmpl_i(&p2G4_dev_state->io, handle);
+}
+
+/**
+ * Get the progress of the packet being received in P2G4_RESP_PAYLOAD_CHUNKED
+ * mode (for ex. during an abort reevaluation)
+ * The bytes [0, progress->received) are already in the reception buffer
+ */
+void p2G4_dev_rx_get_progress_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx_progress_t *progress){
+  *progress = p2G4_dev_state->io.rx_progress;
+}
+
+/**
+ * Get the bit error mask of the packet being/last received
+ * (see P2G4_RESP_ERROR_MASK and p2G4_rx_apply_error_mask())
+ */
+void p2G4_dev_rx_get_error_mask_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx_error_mask_t *mask){
+  p2G4_dev_rx_get_error_mask_i(&p2G4_dev_state->io, mask);
+}
+
+/**
+ * Get the RSSI samples taken during the last reception
+ * (see p2G4_dev_set_rx_rssi_series_s_a())
+ */
+void p2G4_dev_rx_get_rssi_samples_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx_rssi_samples_t *samples){
+  p2G4_dev_rx_get_rssi_samples_i(&p2G4_dev_state->io, samples);
+}
+
+/**
+ * Give back a reception buffer obtained with buf_size = P2G4_RXBUF_FROM_POOL
+ */
+void p2G4_dev_rx_pool_release_s_a(p2G4_dev_state_a_t *p2G4_dev_state, uint8_t *buf){
+  p2G4_rx_pool_release(&p2G4_dev_state->io.rx_pool, buf);
+}
+
+/**
+ * Get the reception buffer pool statistics (hits/misses)
+ */
+void p2G4_dev_rx_pool_get_stats_s_a(p2G4_dev_state_a_t *p2G4_dev_state, p2G4_rx_pool_stats_t *stats){
+  p2G4_rx_pool_get_stats(&p2G4_dev_state->io.rx_pool, stats);
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Rx bit error masks (see P2G4_RESP_ERROR_MASK and P2G4_MSG_RX_ERROR_MASK)
+ *
+ * The phy sends the bits with errors as a list of runs, either in full before
+ * the reception ends, or, when the device asks for it during the reception,
+ * incrementally (only the runs from the bit the device asks onwards).
+ * The library keeps the merged list for the current packet.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "bs_tracing.h"
+#include "bs_oswrap.h"
+#include "bs_pc_2G4_priv.h"
+
+/* Maximum number of runs the phy may send in one mask */
+#define P2G4_ERR_MASK_MAX_RUNS 4096
+
+/**
+ * Forget the error mask of the previous packet (on a new Rx request)
+ */
+void p2G4_err_mask_reset(p2G4_dev_io_t *io) {
+  io->rx_err_n_runs = 0;
+  io->rx_err_calc_bits = 0;
+  io->rx_err_time = 0;
+}
+
+/**
+ * Free the error mask storage of this connection
+ */
+void p2G4_err_mask_free(p2G4_dev_io_t *io) {
+  free(io->rx_err_runs);
+  io->rx_err_runs = NULL;
+  io->rx_err_max_runs = 0;
+  p2G4_err_mask_reset(io);
+}
+
+/**
+ * Handle a P2G4_MSG_RX_ERROR_MASK (after its header has been read):
+ * The runs from start_bit are replaced with the ones the phy sent
+ */
+int p2G4_dev_handle_rx_error_mask_i(p2G4_dev_io_t *io) {
+  p2G4_error_mask_t mask;
+  uint n = io->rx_err_n_runs;
+
+  if (p2G4_dev_read_i(io, &mask, sizeof(p2G4_error_mask_t)) == -1) {
+    return -1;
+  }
+  if (mask.n_runs > P2G4_ERR_MASK_MAX_RUNS) {
+    bs_trace_warning_line("Received a too big Rx error mask (%u runs)"
+                          " => Disconnecting\n", mask.n_runs);
+    p2G4_dev_disconnect_i(io);
+    return -1;
+  }
+
+  /* Drop what we had from start_bit on */
+  while ((n > 0) && (io->rx_err_runs[n - 1].bit >= mask.start_bit)) {
+    n--;
+  }
+  if ((n > 0)
+      && (io->rx_err_runs[n - 1].bit + io->rx_err_runs[n - 1].len > mask.start_bit)) {
+    io->rx_err_runs[n - 1].len = mask.start_bit - io->rx_err_runs[n - 1].bit;
+  }
+
+  if (n + mask.n_runs > io->rx_err_max_runs) {
+    io->rx_err_max_runs = n + mask.n_runs;
+    io->rx_err_runs = bs_realloc(io->rx_err_runs,
+                                 io->rx_err_max_runs*sizeof(p2G4_error_run_t));
+  }
+  if (p2G4_dev_read_i(io, &io->rx_err_runs[n],
+                      mask.n_runs*sizeof(p2G4_error_run_t)) == -1) {
+    return -1;
+  }
+  io->rx_err_n_runs = n + mask.n_runs;
+  io->rx_err_calc_bits = mask.calc_bits;
+  io->rx_err_time = mask.time;
+  return 0;
+}
+
+/**
+ * Request from the phy the error mask of the packet being received,
+ * from <start_bit> on, and wait for it
+ * (During an abort reevaluation or while evaluating the packet header)
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_imm_req_error_mask_i(p2G4_dev_io_t *io, uint32_t start_bit) {
+  p2G4_imm_error_mask_t req = {.start_bit = start_bit};
+  pc_header_t header;
+
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+
+  p2G4_dev_send_msg_i(io, P2G4_MSG_IMM_REQ_ERROR_MASK, (void *)&req,
+                      sizeof(p2G4_imm_error_mask_t));
+  if (p2G4_dev_read_header_i(io, &header) == -1) {
+    return -1;
+  }
+  if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else if (header != P2G4_MSG_RX_ERROR_MASK) {
+    INVALID_RESP(header);
+    return -1;
+  }
+  return p2G4_dev_handle_rx_error_mask_i(io);
+}
+
+void p2G4_dev_rx_get_error_mask_i(p2G4_dev_io_t *io, p2G4_rx_error_mask_t *mask) {
+  mask->runs = io->rx_err_runs;
+  mask->n_runs = io->rx_err_n_runs;
+  mask->calc_bits = io->rx_err_calc_bits;
+  mask->time = io->rx_err_time;
+}
+
+/**
+ * Flip in <buf> (of <size> bytes) the bits the error mask <runs> mark as
+ * erroneous, so the device gets the packet as its receiver would have
+ * (Bits beyond the buffer are ignored)
+ *
+ * Whole bytes inside a run are flipped a 64 bit word at a time
+ */
+void p2G4_rx_apply_error_mask(uint8_t *buf, size_t size,
+                              const p2G4_error_run_t *runs, uint n_runs) {
+  size_t n_bits = size*8;
+
+  for (uint i = 0; i < n_runs; i++) {
+    size_t bit = runs[i].bit;
+    size_t end = bit + runs[i].len;
+    uint8_t *p;
+    size_t n_bytes;
+
+    if (bit >= n_bits) {
+      continue;
+    }
+    if (end > n_bits) {
+      end = n_bits;
+    }
+
+    /* Leading bits, until the next byte boundary */
+    if (bit & 7) {
+      size_t b_end = (bit | 7) + 1;
+      if (b_end > end) {
+        b_end = end;
+      }
+      buf[bit >> 3] ^= ((1U << (b_end - bit)) - 1) << (bit & 7);
+      bit = b_end;
+    }
+
+    /* Whole bytes */
+    p = &buf[bit >> 3];
+    n_bytes = (end - bit) >> 3;
+    bit += n_bytes*8;
+    while (n_bytes >= sizeof(uint64_t)) {
+      uint64_t w;
+      memcpy(&w, p, sizeof(uint64_t));
+      w = ~w;
+      memcpy(p, &w, sizeof(uint64_t));
+      p += sizeof(uint64_t);
+      n_bytes -= sizeof(uint64_t);
+    }
+    while (n_bytes > 0) {
+      *p = ~*p;
+      p++;
+      n_bytes--;
+    }
+
+    /* Trailing bits */
+    if (bit < end) {
+      buf[bit >> 3] ^= (1U << (end - bit)) - 1;
+    }
+  }
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Multiplexed connections: several devices thru one connection to the phy
+ *
+ * See bs_pc_2G4.h for a description
+ */
+
+#include <stdlib.h>
+#include "bs_tracing.h"
+#include "bs_oswrap.h"
+#include "bs_pc_2G4_types.h"
+#include "bs_pc_2G4.h"
+#include "bs_pc_2G4_priv.h"
+
+/**
+ * Connect to the phy as device dev_nbrs[0], and request the phy to
+ * multiplex thru this connection all <n_devs> devices in <dev_nbrs>
+ *
+ * returns -1 on error (including the phy rejecting the multiplexing, in which
+ * case we are disconnected), 0 otherwise
+ */
+int p2G4_mux_initcom(p2G4_mux_t *mux, const uint *dev_nbrs, uint n_devs,
+                     const char* s, const char* p) {
+  p2G4_mux_start_t start;
+  uint32_t *list;
+  uint max = 0;
+  pc_header_t header;
+  int ret;
+
+  if (n_devs == 0) {
+    bs_trace_error_line("A multiplexed connection needs at least 1 device\n");
+  }
+
+  ret = p2G4_dev_init_com_i(&mux->io, &mux->pb_dev_state, dev_nbrs[0], s, p);
+  if (ret != 0) {
+    return ret;
+  }
+
+  list = bs_malloc(n_devs*sizeof(uint32_t));
+  for (uint i = 0; i < n_devs; i++) {
+    list[i] = dev_nbrs[i];
+    if (dev_nbrs[i] > max) {
+      max = dev_nbrs[i];
+    }
+  }
+  mux->n_devs = max + 1;
+  mux->devs = bs_calloc(mux->n_devs, sizeof(p2G4_dev_state_a_t *));
+
+  start.n_devs = n_devs;
+  p2G4_dev_send_msg_payload_i(&mux->io, P2G4_MSG_MUX_START,
+                              &start, sizeof(p2G4_mux_start_t),
+                              list, n_devs*sizeof(uint32_t));
+  free(list);
+
+  /* The phy answers untagged, before it starts tagging its messages */
+  if (p2G4_dev_read_i(&mux->io, &header, sizeof(header)) == -1) {
+    p2G4_mux_disconnect(mux);
+    return -1;
+  }
+  if (header == P2G4_MSG_MUX_START_ACK) {
+    return 0;
+  }
+  if (header == P2G4_MSG_MUX_START_NACK) {
+    bs_trace_warning_line("The phy rejected multiplexing %u devices thru one "
+                          "connection\n", n_devs);
+  } else {
+    bs_trace_warning_line("The phy responded to P2G4_MSG_MUX_START with an "
+                          "unknown/invalid message (%u)\n", header);
+  }
+  p2G4_dev_disconnect_i(&mux->io);
+  p2G4_mux_disconnect(mux);
+  return -1;
+}
+
+/**
+ * File descriptor which becomes readable when the phy sends something to any
+ * of the devices in this connection (see p2G4_dev_get_fd_s_a())
+ *
+ * Note that the connection reads ahead: several phy messages may already be
+ * in its buffer while the fd is not readable anymore. Also, calling
+ * p2G4_dev_poll_s_a() on one device of this connection may read, and queue
+ * in their devices, completions for the other devices.
+ * So before waiting on this fd, the host shall call p2G4_mux_poll() until it
+ * returns 0 (or check p2G4_mux_pending()), and pop the completions queued in
+ * each device it returned.
+ */
+int p2G4_mux_get_fd(p2G4_mux_t *mux) {
+  return p2G4_dev_get_fd_i(&mux->io);
+}
+
+/**
+ * Is there anything from the phy which can be picked (with p2G4_mux_poll())
+ * without blocking, either already read into the connection buffer, or in the
+ * fd/shared memory?
+ *
+ * returns 1 if so, 0 otherwise
+ */
+int p2G4_mux_pending(p2G4_mux_t *mux) {
+  if (!mux->pb_dev_state.connected) {
+    return 0;
+  }
+  return p2G4_dev_rx_ready_i(&mux->io);
+}
+
+/*
+ * Read the next message from the phy, and hand it to the device it is for
+ */
+static int p2G4_mux_pick_one(p2G4_mux_t *mux, p2G4_dev_state_a_t **dev) {
+  p2G4_mux_tag_t tag;
+
+  if (p2G4_dev_read_i(&mux->io, &tag, sizeof(tag)) == -1) {
+    return -1;
+  }
+  if ((tag.dev_nbr >= mux->n_devs) || (mux->devs[tag.dev_nbr] == NULL)) {
+    /* We cannot know how long that message is, so we cannot skip it */
+    bs_trace_warning_line("The phy sent a message for device %u, which is not "
+                          "bound to this connection => disconnecting it\n",
+                          tag.dev_nbr);
+    p2G4_mux_disconnect(mux);
+    return -1;
+  }
+  *dev = mux->devs[tag.dev_nbr];
+  /* An error here only affects that device (which is now disconnected) */
+  p2G4_dev_async_pick_resp_i(*dev);
+
+  if (!mux->pb_dev_state.connected) {
+    return -1;
+  }
+  return 1;
+}
+
+/**
+ * If the phy has sent something (to any device), pick it, queue its
+ * completion in the corresponding device, and point *dev to that device
+ * Otherwise return right away.
+ *
+ * returns 1 if a completion was queued,
+ *         0 if there was nothing yet,
+ *        -1 on error (the connection is gone)
+ */
+int p2G4_mux_poll(p2G4_mux_t *mux, p2G4_dev_state_a_t **dev) {
+  CHECK_CONNECTED(mux->pb_dev_state.connected);
+
+  if (!p2G4_dev_rx_ready_i(&mux->io)) {
+    return 0;
+  }
+  return p2G4_mux_pick_one(mux, dev);
+}
+
+/**
+ * Like p2G4_mux_poll() but blocking until the phy sends something
+ *
+ * returns -1 on error (the connection is gone), 0 otherwise
+ */
+int p2G4_mux_wait_b(p2G4_mux_t *mux, p2G4_dev_state_a_t **dev) {
+  CHECK_CONNECTED(mux->pb_dev_state.connected);
+
+  if (p2G4_mux_pick_one(mux, dev) == -1) {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * Disconnect all devices still bound to this connection, and close it
+ */
+void p2G4_mux_disconnect(p2G4_mux_t *mux) {
+  for (uint i = 0; i < mux->n_devs; i++) {
+    if (mux->devs[i] != NULL) {
+      p2G4_dev_disconnect_s_a(mux->devs[i]);
+    }
+  }
+  if (mux->pb_dev_state.connected) {
+    p2G4_dev_clean_up_i(&mux->io);
+  }
+  free(mux->devs);
+  mux->devs = NULL;
+  mux->n_devs = 0;
+}
@@ -4,45 +4,1159 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
 #include <unistd.h>
+#include <sys/uio.h>
+#include <poll.h>
 #include "bs_tracing.h"
 #include "bs_pc_2G4_types.h"
 #include "bs_pc_2G4_priv.h"
+#include "bs_pc_2G4_shm.h"
 #include "bs_pc_base.h"
 #include "bs_oswrap.h"
 
-void p2G4_dev_req_tx_i(pb_dev_state_t *pb_dev_state, p2G4_tx_t *s,
+/*
+ * Ask the phy to switch to the shared memory transport <shm>, and only do so
+ * if it acknowledges it. Otherwise we just continue with the FIFOs
+ *
+ * returns -1 on error (and we will be disconnected), 0 otherwise
+ */
+static int p2G4_dev_shm_negotiate_i(p2G4_dev_io_t *io, p2G4_shm_t *shm) {
+  pc_header_t header = P2G4_MSG_SHM_ATTACH;
+
+  p2G4_dev_send_i(io, &header, sizeof(header));
+  if (p2G4_dev_read_i(io, &header, sizeof(header)) == -1) {
+    p2G4_shm_detach(shm);
+    return -1;
+  }
+  if (header == P2G4_MSG_SHM_ATTACH_ACK) {
+    io->shm = shm;
+  } else if (header == P2G4_MSG_SHM_ATTACH_NACK) {
+    bs_trace_warning_line("The phy rejected the shared memory transport, "
+                          "using the FIFOs instead\n");
+    p2G4_shm_detach(shm);
+  } else {
+    p2G4_shm_detach(shm);
+    INVALID_RESP(header);
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * Connect to the phy, and if the phy supports it, switch to the shared memory
+ * transport. Otherwise we just continue with the FIFOs
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_init_com_i(p2G4_dev_io_t *io, pb_dev_state_t *pb_dev_state,
+                        uint d, const char* s, const char* p) {
+  int ret;
+
+  memset(io, 0, sizeof(p2G4_dev_io_t));
+  io->pb_dev_state = pb_dev_state;
+
+  ret = pb_dev_init_com(pb_dev_state, d, s, p);
+  if (ret != 0) {
+    return ret;
+  }
+
+  p2G4_shm_t *shm = p2G4_shm_dev_attach(d, s, p, pb_dev_state->ff_ptd);
+  if (shm != NULL) {
+    return p2G4_dev_shm_negotiate_i(io, shm);
+  }
+  return 0;
+}
+
+/**
+ * Set up the connection of a device which goes thru the multiplexed
+ * connection <mux> (already connected)
+ */
+void p2G4_dev_init_mux_i(p2G4_dev_io_t *io, pb_dev_state_t *pb_dev_state,
+                         p2G4_mux_t *mux, uint d) {
+  memset(io, 0, sizeof(p2G4_dev_io_t));
+  memset(pb_dev_state, 0, sizeof(pb_dev_state_t));
+  io->pb_dev_state = pb_dev_state;
+  io->mux = mux;
+  io->mux_dev_nbr = d;
+  pb_dev_state->connected = true;
+}
+
+/* Request options accepted by each type of request (bitmasks of 1 << p2G4_req_opt_kind_t) */
+#define P2G4_OPTS_ABORTABLE (1 << P2G4_REQ_OPT_ABORT_SCHED)
+#define P2G4_OPTS_RXV2      ((1 << P2G4_REQ_OPT_ABORT_SCHED) | (1 << P2G4_REQ_OPT_RX_FILTER) \
+                             | (1 << P2G4_REQ_OPT_RX_ADDR_SET) | (1 << P2G4_REQ_OPT_RX_RSSI_SERIES))
+
+static const char *const p2G4_req_opt_name[P2G4_REQ_OPT_N] = {
+  "abort schedule",
+  "Rx filter",
+  "Rx address set",
+  "Rx RSSI series",
+};
+
+/*
+ * Which request options the message in <iov> accepts,
+ * or -1 if it is not a request (but for ex. a response to the phy)
+ */
+static int p2G4_dev_req_opts_accepted_i(p2G4_dev_io_t *io, struct iovec *iov) {
+  pc_header_t header = *(pc_header_t *)iov[0].iov_base;
+
+  switch (header) {
+  case P2G4_MSG_TX:
+  case P2G4_MSG_TXV2:
+  case P2G4_MSG_TX2V1:
+  case P2G4_MSG_TX_CHAIN:
+  case P2G4_MSG_RX:
+  case P2G4_MSG_CCA_MEAS:
+  case P2G4_MSG_CCAV2_MEAS:
+  case P2G4_MSG_CCA_TX:
+  case P2G4_MSG_CCA_MULTI:
+    return P2G4_OPTS_ABORTABLE;
+  case P2G4_MSG_RXV2:
+  case P2G4_MSG_RX2V1:
+  case P2G4_MSG_RX_STREAM:
+  case P2G4_MSG_RX_CHAIN:
+  case P2G4_MSG_TXRX:
+  case P2G4_MSG_RX_AUTORESP:
+  case P2G4_MSG_RX_MULTI:
+    return P2G4_OPTS_RXV2;
+  case P2G4_MSG_TX2V1_POSTED:
+  case P2G4_MSG_RSSIMEAS:
+  case P2G4_MSG_RSSIV2MEAS:
+  case P2G4_MSG_RSSI_SWEEP:
+  case PB_MSG_WAIT:
+    return 0;
+  case P2G4_MSG_TMPL_INST: {
+    p2G4_tmpl_inst_t *inst = (p2G4_tmpl_inst_t *)iov[1].iov_base;
+    if (inst->fields & P2G4_TMPL_POSTED) {
+      return 0;
+    }
+    if (p2G4_tmpl_req_i(io, inst->handle) == P2G4_MSG_RX2V1) {
+      return P2G4_OPTS_RXV2;
+    }
+    return P2G4_OPTS_ABORTABLE;
+  }
+  default:
+    return -1;
+  }
+}
+
+/*
+ * If <iov> is a request, point <frame> to the pending request options, to
+ * send them right before it, in its same frame (they are not pending anymore
+ * then). It is an error if any of them does not apply to that request.
+ * Other messages leave them pending.
+ *
+ * returns the number of options placed in <frame>
+ */
+static int p2G4_dev_take_req_opts_i(p2G4_dev_io_t *io, struct iovec *iov,
+                                    struct iovec *frame) {
+  int accepted = -1;
+  int n = 0;
+
+  for (int k = 0; k < P2G4_REQ_OPT_N; k++) {
+    p2G4_req_opt_t *opt = &io->req_opts[k];
+
+    if (opt->size == 0) {
+      continue;
+    }
+    if (accepted == -1) {
+      accepted = p2G4_dev_req_opts_accepted_i(io, iov);
+      if (accepted == -1) {
+        return 0;
+      }
+    }
+    if ((accepted & (1 << k)) == 0) {
+      bs_trace_error_line("The pending %s does not apply to the next request (0x%X)\n",
+                          p2G4_req_opt_name[k], *(pc_header_t *)iov[0].iov_base);
+    }
+    frame[n].iov_base = opt->buf;
+    frame[n++].iov_len = opt->size;
+    opt->size = 0;
+  }
+  return n;
+}
+
+/**
+ * Keep the option message <header> (followed by <size> bytes of <buf>, followed
+ * by <p_size> bytes of <payload>) for the next request, to send it in the same
+ * frame, right before it. It replaces any option of the same <kind> not sent yet.
+ */
+void p2G4_dev_set_req_opt_i(p2G4_dev_io_t *io, p2G4_req_opt_kind_t kind, pc_header_t header,
+                            void *buf, size_t size, void *payload, size_t p_size) {
+  p2G4_req_opt_t *opt = &io->req_opts[kind];
+  size_t tag_size = (io->mux != NULL) ? sizeof(p2G4_mux_tag_t) : 0;
+  size_t total = tag_size + sizeof(pc_header_t) + size + p_size;
+  uint8_t *p;
+
+  if (total > opt->max) {
+    opt->max = total;
+    opt->buf = bs_realloc(opt->buf, opt->max);
+  }
+  p = opt->buf;
+  if (io->mux != NULL) {
+    p2G4_mux_tag_t tag = {.dev_nbr = io->mux_dev_nbr};
+    memcpy(p, &tag, tag_size);
+    p += tag_size;
+  }
+  memcpy(p, &header, sizeof(pc_header_t));
+  p += sizeof(pc_header_t);
+  if (size > 0) {
+    memcpy(p, buf, size);
+    p += size;
+  }
+  if (p_size > 0) {
+    memcpy(p, payload, p_size);
+  }
+  opt->size = total;
+}
+
+static void p2G4_dev_free_req_opts_i(p2G4_dev_io_t *io) {
+  for (int k = 0; k < P2G4_REQ_OPT_N; k++) {
+    free(io->req_opts[k].buf);
+    io->req_opts[k].buf = NULL;
+    io->req_opts[k].size = 0;
+    io->req_opts[k].max = 0;
+  }
+}
+
+/*
+ * Send to the phy all the <iovcnt> buffers in <iov> in one go
+ * (one single syscall with the FIFOs, or one ring update with the shared memory)
+ * For a request, its pending options go in the same frame, right before it.
+ */
+void p2G4_dev_sendv_i(p2G4_dev_io_t *io, struct iovec *iov, int iovcnt) {
+  /* Room for the request options and the device tag */
+  struct iovec frame[P2G4_REQ_OPT_N + 1 + P2G4_IO_MAX_IOV];
+  p2G4_mux_tag_t tag;
+  int n;
+
+  if (iovcnt > P2G4_IO_MAX_IOV) {
+    bs_trace_error_line("Too many buffers in one frame (%i)\n", iovcnt);
+  }
+  n = p2G4_dev_take_req_opts_i(io, iov, frame);
+  if (io->mux != NULL) {
+    /* Prefix the message with the device tag, and send it thru the shared connection */
+    tag.dev_nbr = io->mux_dev_nbr;
+    frame[n].iov_base = &tag;
+    frame[n++].iov_len = sizeof(tag);
+    io = &io->mux->io;
+  }
+  memcpy(&frame[n], iov, iovcnt*sizeof(struct iovec));
+  iov = frame;
+  iovcnt += n;
+
+  if (!io->pb_dev_state->connected) {
+    return;
+  }
+
+  if (io->shm != NULL) {
+    if (p2G4_shm_writev(&io->shm->tx, iov, iovcnt) != 0) {
+      bs_trace_warning_line("The phy disappeared (shared memory transport)\n");
+      p2G4_dev_clean_up_i(io);
+    }
+    return;
+  }
+
+  while (iovcnt > 0) {
+    ssize_t written = writev(io->pb_dev_state->ff_dtp, iov, iovcnt);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      bs_trace_warning_line("Error writing to the phy (%i)\n", errno);
+      p2G4_dev_clean_up_i(io);
+      return;
+    }
+    /* Partial write (only possible for frames over PIPE_BUF): continue after it */
+    while ((iovcnt > 0) && ((size_t)written >= iov->iov_len)) {
+      written -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if (iovcnt > 0) {
+      iov->iov_base = (uint8_t *)iov->iov_base + written;
+      iov->iov_len -= written;
+    }
+  }
+}
+
+/**
+ * Send to the phy, as one single frame, a message header followed by <size>
+ * bytes of <buf>, followed by <p_size> bytes of <payload>
+ * Either buffer may be empty (size 0)
+ */
+void p2G4_dev_send_msg_payload_i(p2G4_dev_io_t *io, pc_header_t header,
+                                 void *buf, size_t size,
+                                 void *payload, size_t p_size) {
+  struct iovec iov[3];
+  int n = 0;
+
+  iov[n].iov_base = &header;
+  iov[n++].iov_len = sizeof(header);
+  if (size > 0) {
+    iov[n].iov_base = buf;
+    iov[n++].iov_len = size;
+  }
+  if (p_size > 0) {
+    iov[n].iov_base = payload;
+    iov[n++].iov_len = p_size;
+  }
+  p2G4_dev_sendv_i(io, iov, n);
+}
+
+/**
+ * Send a message header followed by <size> bytes of <buf> to the phy
+ */
+void p2G4_dev_send_msg_i(p2G4_dev_io_t *io, pc_header_t header, void *buf,
+                         size_t size) {
+  p2G4_dev_send_msg_payload_i(io, header, buf, size, NULL, 0);
+}
+
+/**
+ * Send <size> bytes of <buf> to the phy (without any header)
+ */
+void p2G4_dev_send_i(p2G4_dev_io_t *io, void *buf, size_t size) {
+  struct iovec iov = {.iov_base = buf, .iov_len = size};
+
+  if (size == 0) {
+    return;
+  }
+  p2G4_dev_sendv_i(io, &iov, 1);
+}
+
+/*
+ * Read from the phy into <buf> at least <min> bytes, and at most <max>
+ * (whatever is already available), blocking until at least <min> are there
+ *
+ * returns the number of read bytes, or -1 on error (and we will be disconnected)
+ */
+static ssize_t p2G4_dev_raw_read_i(p2G4_dev_io_t *io, uint8_t *buf, size_t min, size_t max) {
+  size_t done = 0;
+
+  if (!io->pb_dev_state->connected) {
+    return -1;
+  }
+
+  if (io->shm != NULL) {
+    ssize_t ret = p2G4_shm_read_some(&io->shm->rx, buf, min, max);
+    if (ret < 0) {
+      bs_trace_warning_line("The phy disappeared (shared memory transport)\n");
+      p2G4_dev_clean_up_i(io);
+    }
+    return ret;
+  }
+
+  while (done < min) {
+    ssize_t ret = read(io->pb_dev_state->ff_ptd, &buf[done], max - done);
+    if (ret > 0) {
+      done += ret;
+    } else if ((ret < 0) && (errno == EINTR)) {
+      continue;
+    } else {
+      if (ret == 0) {
+        bs_trace_warning_line("The phy disconnected us\n");
+      } else {
+        bs_trace_warning_line("Error reading from the phy (%i)\n", errno);
+      }
+      p2G4_dev_clean_up_i(io);
+      return -1;
+    }
+  }
+  return done;
+}
+
+/*
+ * Ensure at least <size> bytes are in the receive buffer
+ *
+ * returns -1 on error (and we will be disconnected), 0 otherwise
+ */
+static int p2G4_dev_fill_i(p2G4_dev_io_t *io, size_t size) {
+  size_t avail = io->rx_end - io->rx_start;
+  ssize_t ret;
+
+  if (avail >= size) {
+    return 0;
+  }
+  if (io->rx_buf_size < size) {
+    size_t new_size = P2G4_IO_RX_BUF_SIZE;
+    while (new_size < size) {
+      new_size *= 2;
+    }
+    io->rx_buf = bs_realloc(io->rx_buf, new_size);
+    io->rx_buf_size = new_size;
+  }
+  if (io->rx_buf_size - io->rx_start < size) {
+    memmove(io->rx_buf, &io->rx_buf[io->rx_start], avail);
+    io->rx_start = 0;
+    io->rx_end = avail;
+  }
+
+  ret = p2G4_dev_raw_read_i(io, &io->rx_buf[io->rx_end], size - avail,
+                            io->rx_buf_size - io->rx_end);
+  if (ret < 0) {
+    return -1;
+  }
+  io->rx_end += ret;
+  return 0;
+}
+
+/**
+ * Block until reading <size> bytes from the phy into <buf>
+ *
+ * Whatever else the phy has already sent is kept in the receive buffer,
+ * so later reads will not need to go to the OS.
+ *
+ * returns -1 on error (and we will be disconnected), 0 otherwise
+ */
+int p2G4_dev_read_i(p2G4_dev_io_t *io, void *buf, size_t size) {
+  size_t avail = io->rx_end - io->rx_start;
+  uint8_t *dst = (uint8_t *)buf;
+
+  if (io->mux != NULL) {
+    if (p2G4_dev_read_i(&io->mux->io, buf, size) == -1) {
+      io->pb_dev_state->connected = false;
+      return -1;
+    }
+    return 0;
+  }
+
+  if (avail >= size) {
+    memcpy(dst, &io->rx_buf[io->rx_start], size);
+    io->rx_start += size;
+    return 0;
+  }
+
+  if (avail > 0) {
+    memcpy(dst, &io->rx_buf[io->rx_start], avail);
+    dst += avail;
+    size -= avail;
+  }
+  io->rx_start = 0;
+  io->rx_end = 0;
+
+  if (size >= P2G4_IO_RX_BUF_SIZE) {
+    /* Big payload: no point in copying it twice */
+    if (p2G4_dev_raw_read_i(io, dst, size, size) < 0) {
+      return -1;
+    }
+    return 0;
+  }
+
+  if (p2G4_dev_fill_i(io, size) != 0) {
+    return -1;
+  }
+  memcpy(dst, io->rx_buf, size);
+  io->rx_start = size;
+  return 0;
+}
+
+/**
+ * Block until <size> bytes have been received from the phy, and return a
+ * pointer to them inside the receive buffer (instead of copying them)
+ *
+ * The returned pointer is only valid until the next read from this connection
+ *
+ * returns NULL on error (and we will be disconnected)
+ */
+void *p2G4_dev_read_ref_i(p2G4_dev_io_t *io, size_t size) {
+  void *ptr;
+
+  if (io->mux != NULL) {
+    ptr = p2G4_dev_read_ref_i(&io->mux->io, size);
+    if (ptr == NULL) {
+      io->pb_dev_state->connected = false;
+    }
+    return ptr;
+  }
+
+  if (p2G4_dev_fill_i(io, size) != 0) {
+    return NULL;
+  }
+  ptr = &io->rx_buf[io->rx_start];
+  io->rx_start += size;
+  return ptr;
+}
+
+/**
+ * Is there something from the phy which can be read without blocking?
+ * (either already in the receive buffer, or waiting in the FIFO/ring)
+ * Note that if the phy is gone, this also returns 1 (so the next read will find it out)
+ *
+ * returns 1 if so, 0 otherwise
+ */
+int p2G4_dev_rx_ready_i(p2G4_dev_io_t *io) {
+  struct pollfd pfd;
+
+  if (io->mux != NULL) {
+    return p2G4_dev_rx_ready_i(&io->mux->io);
+  }
+
+  if (io->rx_end > io->rx_start) {
+    return 1;
+  }
+  if (io->shm != NULL) {
+    if (p2G4_shm_available(&io->shm->rx) > 0) {
+      return 1;
+    }
+  }
+  pfd.fd = io->pb_dev_state->ff_ptd;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  if (poll(&pfd, 1, 0) <= 0) {
+    return 0;
+  }
+  if ((io->shm != NULL) && !(pfd.revents & (POLLHUP | POLLERR))) {
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * File descriptor which becomes readable when the phy sends something
+ * (for the device to wait on it with poll/select/epoll)
+ *
+ * Returns -1 if there is no such fd (not connected, or using the shared
+ * memory transport)
+ */
+int p2G4_dev_get_fd_i(p2G4_dev_io_t *io) {
+  if (io->mux != NULL) {
+    return p2G4_dev_get_fd_i(&io->mux->io);
+  }
+  if (!io->pb_dev_state->connected || (io->shm != NULL)) {
+    return -1;
+  }
+  return io->pb_dev_state->ff_ptd;
+}
+
+static void p2G4_dev_free_addr_sets_i(p2G4_dev_io_t *io) {
+  free(io->addr_sets_live);
+  io->addr_sets_live = NULL;
+  io->addr_sets_words = 0;
+  io->addr_set_pending = 0;
+}
+
+static void p2G4_dev_free_io_i(p2G4_dev_io_t *io) {
+  p2G4_rx_pool_free(&io->rx_pool);
+  p2G4_dev_free_req_opts_i(io);
+  p2G4_dev_free_addr_sets_i(io);
+  p2G4_tmpl_free(io);
+  p2G4_err_mask_free(io);
+  p2G4_rssi_series_free(io);
+  p2G4_shm_detach(io->shm);
+  io->shm = NULL;
+  free(io->rx_buf);
+  io->rx_buf = NULL;
+  io->rx_buf_size = 0;
+  io->rx_start = 0;
+  io->rx_end = 0;
+}
+
+/**
+ * Free all resources of the connection, without notifying the phy
+ */
+void p2G4_dev_clean_up_i(p2G4_dev_io_t *io) {
+  if (io->mux != NULL) {
+    /* Only this device is gone, the shared connection stays */
+    io->pb_dev_state->connected = false;
+    if (io->mux_dev_nbr < io->mux->n_devs) {
+      io->mux->devs[io->mux_dev_nbr] = NULL;
+    }
+    p2G4_rx_pool_free(&io->rx_pool);
+    p2G4_dev_free_req_opts_i(io);
+    p2G4_dev_free_addr_sets_i(io);
+    p2G4_tmpl_free(io);
+    p2G4_err_mask_free(io);
+    p2G4_rssi_series_free(io);
+    return;
+  }
+  pb_dev_clean_up(io->pb_dev_state);
+  p2G4_dev_free_io_i(io);
+}
+
+/**
+ * Disconnect from the phy
+ */
+void p2G4_dev_disconnect_i(p2G4_dev_io_t *io) {
+  if ((io->shm == NULL) && (io->mux == NULL)) {
+    pb_dev_disconnect(io->pb_dev_state);
+    p2G4_dev_free_io_i(io);
+    return;
+  }
+  if (io->pb_dev_state->connected) {
+    pc_header_t header = PB_MSG_DISCONNECT;
+    p2G4_dev_send_i(io, &header, sizeof(header));
+  }
+  p2G4_dev_clean_up_i(io);
+}
+
+/**
+ * Attempt to terminate the simulation, and disconnect from the phy
+ */
+void p2G4_dev_terminate_i(p2G4_dev_io_t *io) {
+  if ((io->shm == NULL) && (io->mux == NULL)) {
+    pb_dev_terminate(io->pb_dev_state);
+    p2G4_dev_free_io_i(io);
+    return;
+  }
+  if (io->pb_dev_state->connected) {
+    pc_header_t header = PB_MSG_TERMINATE;
+    p2G4_dev_send_i(io, &header, sizeof(header));
+  }
+  p2G4_dev_clean_up_i(io);
+}
+
+/**
+ * Request a wait to the phy, without waiting for its response
+ */
+int p2G4_dev_req_wait_i(p2G4_dev_io_t *io, pb_wait_t *wait_s) {
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+  p2G4_dev_send_msg_i(io, PB_MSG_WAIT, (void *)wait_s, sizeof(pb_wait_t));
+  return 0;
+}
+
+/**
+ * Block until getting a wait response from the phy
+ *
+ * returns -1 on error (and we will be disconnected), 0 otherwise
+ */
+int p2G4_dev_pick_wait_resp_i(p2G4_dev_io_t *io) {
+  pc_header_t header;
+
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+  if (p2G4_dev_read_header_i(io, &header) == -1) {
+    return -1;
+  }
+  if (header == PB_MSG_WAIT_END) {
+    return 0;
+  } else if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else {
+    INVALID_RESP(header);
+    return -1;
+  }
+}
+
+/**
+ * Request a wait to the phy and block until receiving its response
+ *
+ * returns -1 on error (and we will be disconnected), 0 otherwise
+ */
+int p2G4_dev_req_wait_b_i(p2G4_dev_io_t *io, pb_wait_t *wait_s) {
+  if (p2G4_dev_req_wait_i(io, wait_s) != 0) {
+    return -1;
+  }
+  return p2G4_dev_pick_wait_resp_i(io);
+}
+
+/**
+ * Set a schedule of <n_steps> abort substructures for the next
+ * Tx, Rx or CCA request (see P2G4_MSG_ABORT_SCHED), to be sent with it
+ */
+int p2G4_dev_set_abort_sched_i(p2G4_dev_io_t *io, p2G4_abort_t *steps, uint n_steps) {
+  p2G4_abort_sched_t sched;
+
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+  if (n_steps > P2G4_ABORT_SCHED_MAX_STEPS) {
+    bs_trace_error_line("Too many abort schedule steps (%u > %u)\n",
+                        n_steps, P2G4_ABORT_SCHED_MAX_STEPS);
+  }
+  sched.n_steps = n_steps;
+  p2G4_dev_set_req_opt_i(io, P2G4_REQ_OPT_ABORT_SCHED, P2G4_MSG_ABORT_SCHED,
+                         &sched, sizeof(p2G4_abort_sched_t),
+                         steps, n_steps*sizeof(p2G4_abort_t));
+  return 0;
+}
+
+int p2G4_dev_set_rx_filter_i(p2G4_dev_io_t *io, p2G4_rx_filter_t *filter,
+                             p2G4_rx_filter_rule_t *rules) {
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+  if (filter->n_rules > P2G4_RX_FILTER_MAX_RULES) {
+    bs_trace_error_line("Too many Rx filter rules (%u > %u)\n",
+                        filter->n_rules, P2G4_RX_FILTER_MAX_RULES);
+  }
+  p2G4_dev_set_req_opt_i(io, P2G4_REQ_OPT_RX_FILTER, P2G4_MSG_RX_FILTER,
+                         filter, sizeof(p2G4_rx_filter_t),
+                         rules, filter->n_rules*sizeof(p2G4_rx_filter_rule_t));
+  io->rx_filter_set = (filter->ask_device == 0);
+  return 0;
+}
+
+static bool p2G4_dev_addr_set_live_i(p2G4_dev_io_t *io, uint32_t handle) {
+  uint32_t w = handle / 32;
+
+  return (w < io->addr_sets_words)
+         && (io->addr_sets_live[w] & ((uint32_t)1 << (handle % 32)));
+}
+
+static void p2G4_dev_addr_set_mark_i(p2G4_dev_io_t *io, uint32_t handle, bool live) {
+  uint32_t w = handle / 32;
+
+  if (w >= io->addr_sets_words) {
+    uint32_t n_words = w + 1 > 2*io->addr_sets_words ? w + 1 : 2*io->addr_sets_words;
+
+    io->addr_sets_live = bs_realloc(io->addr_sets_live, n_words*sizeof(uint32_t));
+    memset(&io->addr_sets_live[io->addr_sets_words], 0,
+           (n_words - io->addr_sets_words)*sizeof(uint32_t));
+    io->addr_sets_words = n_words;
+  }
+  if (live) {
+    io->addr_sets_live[w] |= (uint32_t)1 << (handle % 32);
+  } else {
+    io->addr_sets_live[w] &= ~((uint32_t)1 << (handle % 32));
+  }
+}
+
+/*
+ * Handle the phy response to a P2G4_MSG_ADDR_SET_REGISTER (once its header
+ * has been read): on P2G4_MSG_ADDR_SET_ACK the set handle becomes usable.
+ *
+ * returns -1 on error (and we will be disconnected), 0 otherwise
+ * (also when the phy rejected the set)
+ */
+int p2G4_dev_handle_addr_set_resp_i(p2G4_dev_io_t *io, pc_header_t header) {
+  p2G4_addr_set_t set;
+
+  if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else if ((header != P2G4_MSG_ADDR_SET_ACK) && (header != P2G4_MSG_ADDR_SET_NACK)) {
+    INVALID_RESP(header);
+    return -1;
+  }
+  if (p2G4_dev_read_i(io, &set, sizeof(p2G4_addr_set_t)) == -1) {
+    return -1;
+  }
+  if ((io->addr_set_pending == 0) || (set.handle != io->addr_set_pending)) {
+    bs_trace_warning_line("The phy answered to the registration of address set %u, "
+                          "which was not being registered => Disconnecting\n",
+                          set.handle);
+    p2G4_dev_disconnect_i(io);
+    return -1;
+  }
+  io->addr_set_pending = 0;
+  if (header == P2G4_MSG_ADDR_SET_NACK) {
+    bs_trace_warning_line("The phy rejected the address set %u\n", set.handle);
+    return 0;
+  }
+  p2G4_dev_addr_set_mark_i(io, set.handle, true);
+  return 0;
+}
+
+/*
+ * Register an address set, and wait for the phy to accept it.
+ * In a multiplexed connection the phy response comes thru the shared
+ * connection, where responses to other devices may come before it.
+ *
+ * returns -1 on error or if the phy rejected the set, 0 otherwise
+ */
+int p2G4_dev_addr_set_register_i(p2G4_dev_io_t *io, p2G4_address_t *addr,
+                                 uint32_t n_addr, uint32_t *handle) {
+  p2G4_addr_set_t set;
+  pc_header_t header;
+
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+  set.handle = ++io->last_addr_set;
+  set.n_addr = n_addr;
+  io->addr_set_pending = set.handle;
+  p2G4_dev_send_msg_payload_i(io, P2G4_MSG_ADDR_SET_REGISTER,
+                              &set, sizeof(p2G4_addr_set_t),
+                              addr, n_addr*sizeof(p2G4_address_t));
+
+  while (io->addr_set_pending != 0) {
+    if (!io->pb_dev_state->connected) {
+      return -1;
+    }
+    if (io->mux != NULL) {
+      p2G4_dev_state_a_t *dev;
+      if (p2G4_mux_wait_b(io->mux, &dev) == -1) {
+        return -1;
+      }
+    } else {
+      if (p2G4_dev_read_header_i(io, &header) == -1) {
+        return -1;
+      }
+      if (p2G4_dev_handle_addr_set_resp_i(io, header) == -1) {
+        return -1;
+      }
+    }
+  }
+  if (!p2G4_dev_addr_set_live_i(io, set.handle)) {
+    return -1;
+  }
+  *handle = set.handle;
+  return 0;
+}
+
+static void p2G4_dev_addr_set_check_i(p2G4_dev_io_t *io, uint32_t handle) {
+  if (!p2G4_dev_addr_set_live_i(io, handle)) {
+    bs_trace_error_line("Unknown or released address set handle (%u)\n", handle);
+  }
+}
+
+int p2G4_dev_addr_set_release_i(p2G4_dev_io_t *io, uint32_t handle) {
+  p2G4_addr_set_t set = {.handle = handle, .n_addr = 0};
+  p2G4_req_opt_t *opt = &io->req_opts[P2G4_REQ_OPT_RX_ADDR_SET];
+
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+  p2G4_dev_addr_set_check_i(io, handle);
+  if (opt->size >= sizeof(p2G4_addr_set_t)) {
+    p2G4_addr_set_t sel;
+    memcpy(&sel, opt->buf + opt->size - sizeof(p2G4_addr_set_t), sizeof(p2G4_addr_set_t));
+    if (sel.handle == handle) {
+      bs_trace_error_line("Released address set %u, selected for the next Rx request\n",
+                          handle);
+    }
+  }
+  p2G4_dev_send_msg_i(io, P2G4_MSG_ADDR_SET_RELEASE, &set, sizeof(p2G4_addr_set_t));
+  p2G4_dev_addr_set_mark_i(io, handle, false);
+  return 0;
+}
+
+int p2G4_dev_set_rx_addr_set_i(p2G4_dev_io_t *io, uint32_t handle) {
+  p2G4_addr_set_t set = {.handle = handle, .n_addr = 0};
+
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+  p2G4_dev_addr_set_check_i(io, handle);
+  p2G4_dev_set_req_opt_i(io, P2G4_REQ_OPT_RX_ADDR_SET, P2G4_MSG_RX_ADDR_SET,
+                         &set, sizeof(p2G4_addr_set_t), NULL, 0);
+  return 0;
+}
+
+void p2G4_dev_req_tx_i(p2G4_dev_io_t *io, p2G4_tx_t *s,
+                       uint8_t *buf)
+{
+  p2G4_dev_send_msg_payload_i(io, P2G4_MSG_TX, (void *)s, sizeof(p2G4_tx_t),
+                              buf, s->packet_size);
+}
+
+void p2G4_dev_req_txv2_i(p2G4_dev_io_t *io, p2G4_txv2_t *s,
                        uint8_t *buf)
 {
-  pb_send_msg(pb_dev_state->ff_dtp, P2G4_MSG_TX, (void *)s, sizeof(p2G4_tx_t));
-  pb_send_payload(pb_dev_state->ff_dtp, buf, s->packet_size);
+  p2G4_dev_send_msg_payload_i(io, P2G4_MSG_TXV2, (void *)s, sizeof(p2G4_txv2_t),
+                              buf, s->packet_size);
+}
+
+void p2G4_dev_req_tx2v1_i(p2G4_dev_io_t *io, p2G4_tx2v1_t *s, uint8_t *buf)
+{
+  if (p2G4_dev_send_tmpl_i(io, P2G4_MSG_TX2V1, s, NULL, buf)) {
+    return;
+  }
+  p2G4_dev_send_msg_payload_i(io, P2G4_MSG_TX2V1, (void *)s, sizeof(p2G4_tx2v1_t),
+                              buf, s->packet_size);
 }
 
-void p2G4_dev_req_txv2_i(pb_dev_state_t *pb_dev_state, p2G4_txv2_t *s,
-                       uint8_t *buf)
+/**
+ * Can this transmission be posted (not waiting for the phy response)?
+ */
+bool p2G4_dev_tx2v1_postable_i(p2G4_tx2v1_t *s)
+{
+  return (s->abort.abort_time == TIME_NEVER) && (s->abort.recheck_time == TIME_NEVER);
+}
+
+/**
+ * Request a transmission (v2.1) for which the phy will not respond,
+ * and fill tx_done_s as the phy would have on the P2G4_MSG_TX_END
+ */
+void p2G4_dev_req_tx2v1_posted_i(p2G4_dev_io_t *io, p2G4_tx2v1_t *s, uint8_t *buf,
+                                 p2G4_tx_done_t *tx_done_s)
+{
+  if (!p2G4_dev_send_tmpl_i(io, P2G4_MSG_TX2V1_POSTED, s, NULL, buf)) {
+    p2G4_dev_send_msg_payload_i(io, P2G4_MSG_TX2V1_POSTED, (void *)s, sizeof(p2G4_tx2v1_t),
+                                buf, s->packet_size);
+  }
+  tx_done_s->end_time = s->end_tx_time;
+  io->posted_tx++;
+}
+
+/**
+ * Handle a P2G4_MSG_TX_POSTED_FAIL (read ahead of the response to the next
+ * request after posted transmissions):
+ * The device already continued with the tx_done we filled for it, so there
+ * is no way to reconcile it anymore. We disconnect.
+ *
+ * returns -1
+ */
+int p2G4_dev_handle_tx_posted_fail_i(p2G4_dev_io_t *io)
+{
+  p2G4_tx_done_t tx_done;
+
+  if (io->posted_tx == 0) {
+    INVALID_RESP(P2G4_MSG_TX_POSTED_FAIL);
+  }
+  if (p2G4_dev_read_i(io, &tx_done, sizeof(p2G4_tx_done_t)) == -1) {
+    return -1;
+  }
+  bs_trace_warning_line("The phy could not perform a posted Tx as requested "
+                        "(it ended at %llu), disconnecting\n",
+                        (unsigned long long)tx_done.end_time);
+  p2G4_dev_disconnect_i(io);
+  return -1;
+}
+
+/**
+ * Request a chained transmission, checking first that its segments
+ * follow each other as required (see p2G4_tx_chain_t).
+ * <packet> contains all the segments payloads, one after the other
+ */
+void p2G4_dev_req_tx_chain_i(p2G4_dev_io_t *io, p2G4_tx_chain_t *chain,
+                             p2G4_tx2v1_t *segs, uint8_t *packet)
+{
+  pc_header_t header = P2G4_MSG_TX_CHAIN;
+  size_t p_size = 0;
+
+  if ((chain->n_segs == 0) || (chain->n_segs > P2G4_CHAIN_MAX_SEGS)) {
+    bs_trace_error_line("Invalid number of segments in a Tx chain (%u)\n", chain->n_segs);
+  }
+  for (uint i = 0; i < chain->n_segs; i++) {
+    if (i > 0) {
+      if (segs[i - 1].end_tx_time != segs[i - 1].end_packet_time) {
+        bs_trace_error_line("Tx chain segment %u: end_tx_time != end_packet_time\n", i - 1);
+      }
+      if (segs[i].start_tx_time != segs[i - 1].end_tx_time + 1) {
+        bs_trace_error_line("Tx chain segment %u: start_tx_time != previous end_tx_time + 1\n", i);
+      }
+      if (segs[i].start_tx_time != segs[i].start_packet_time) {
+        bs_trace_error_line("Tx chain segment %u: start_tx_time != start_packet_time\n", i);
+      }
+    }
+    p_size += segs[i].packet_size;
+  }
+
+  struct iovec iov[4] = {
+    {.iov_base = &header, .iov_len = sizeof(header)},
+    {.iov_base = chain, .iov_len = sizeof(p2G4_tx_chain_t)},
+    {.iov_base = segs, .iov_len = chain->n_segs*sizeof(p2G4_tx2v1_t)},
+    {.iov_base = packet, .iov_len = p_size},
+  };
+  p2G4_dev_sendv_i(io, iov, p_size > 0 ? 4 : 3);
+}
+
+/*
+ * Prepare for a new Rx request:
+ * Take note if the phy may accept packets on its own for this request
+ * (in which case it will send the packet with the P2G4_MSG_RXV2_END),
+ * and forget the previous packet error mask and RSSI samples
+ */
+static void p2G4_dev_rx_start_i(p2G4_dev_io_t *io)
+{
+  io->rx_end_payload = io->rx_filter_set;
+  io->rx_filter_set = false;
+  p2G4_err_mask_reset(io);
+  p2G4_rssi_series_reset(io);
+}
+
+void p2G4_dev_req_rx_i(p2G4_dev_io_t *io, p2G4_rx_t *s)
+{
+  p2G4_dev_rx_start_i(io);
+  io->rx_resp_type = 0;
+  p2G4_dev_send_msg_i(io, P2G4_MSG_RX, (void *)s, sizeof(p2G4_rx_t));
+}
+
+void p2G4_dev_req_rxv2_i(p2G4_dev_io_t *io, p2G4_rxv2_t *s, p2G4_address_t *phy_addr)
+{
+  p2G4_dev_rx_start_i(io);
+  io->rx_resp_type = s->resp_type;
+  p2G4_dev_send_msg_payload_i(io, P2G4_MSG_RXV2, (void *)s, sizeof(p2G4_rxv2_t),
+                              phy_addr, sizeof(p2G4_address_t)*s->n_addr);
+}
+
+void p2G4_dev_req_rx2v1_i(p2G4_dev_io_t *io, p2G4_rx2v1_t *s, p2G4_address_t *phy_addr)
+{
+  p2G4_dev_rx_start_i(io);
+  io->rx_resp_type = s->resp_type;
+  if (p2G4_dev_send_tmpl_i(io, P2G4_MSG_RX2V1, s, phy_addr, NULL)) {
+    return;
+  }
+  p2G4_dev_send_msg_payload_i(io, P2G4_MSG_RX2V1, (void *)s, sizeof(p2G4_rx2v1_t),
+                              phy_addr, sizeof(p2G4_address_t)*s->n_addr);
+}
+
+void p2G4_dev_req_rx_stream_i(p2G4_dev_io_t *io, p2G4_rx_stream_t *s,
+                              p2G4_address_t *phy_addr, p2G4_freq2_t *channels)
+{
+  pc_header_t header = P2G4_MSG_RX_STREAM;
+  struct iovec iov[4];
+  int n = 0;
+
+  p2G4_dev_rx_start_i(io);
+  io->rx_resp_type = s->rx.resp_type;
+  iov[n].iov_base = &header;
+  iov[n++].iov_len = sizeof(header);
+  iov[n].iov_base = s;
+  iov[n++].iov_len = sizeof(p2G4_rx_stream_t);
+  if (s->rx.n_addr > 0) {
+    iov[n].iov_base = phy_addr;
+    iov[n++].iov_len = sizeof(p2G4_address_t)*s->rx.n_addr;
+  }
+  if (s->n_channels > 0) {
+    iov[n].iov_base = channels;
+    iov[n++].iov_len = sizeof(p2G4_freq2_t)*s->n_channels;
+  }
+  p2G4_dev_sendv_i(io, iov, n);
+}
+
+void p2G4_dev_req_rx_chain_i(p2G4_dev_io_t *io, p2G4_rx_chain_t *chain, p2G4_rx2v1_t *s,
+                             p2G4_address_t *phy_addr, p2G4_rx_chain_seg_t *segs)
+{
+  pc_header_t header = P2G4_MSG_RX_CHAIN;
+  struct iovec iov[5];
+  int n = 0;
+
+  if (chain->n_next >= P2G4_CHAIN_MAX_SEGS) {
+    bs_trace_error_line("Too many segments in a Rx chain (%u)\n", chain->n_next + 1);
+  }
+  if ((s->resp_type & P2G4_RESP_PAYLOAD_MASK) == P2G4_RESP_PAYLOAD_CHUNKED) {
+    bs_trace_error_line("Chunked payload delivery is not supported for Rx chains\n");
+  }
+
+  p2G4_dev_rx_start_i(io);
+  io->rx_resp_type = s->resp_type;
+  iov[n].iov_base = &header;
+  iov[n++].iov_len = sizeof(header);
+  iov[n].iov_base = chain;
+  iov[n++].iov_len = sizeof(p2G4_rx_chain_t);
+  iov[n].iov_base = s;
+  iov[n++].iov_len = sizeof(p2G4_rx2v1_t);
+  if (s->n_addr > 0) {
+    iov[n].iov_base = phy_addr;
+    iov[n++].iov_len = sizeof(p2G4_address_t)*s->n_addr;
+  }
+  if (chain->n_next > 0) {
+    iov[n].iov_base = segs;
+    iov[n++].iov_len = sizeof(p2G4_rx_chain_seg_t)*chain->n_next;
+  }
+  p2G4_dev_sendv_i(io, iov, n);
+}
+
+void p2G4_dev_req_txrx_i(p2G4_dev_io_t *io, p2G4_txrx_t *s, p2G4_address_t *phy_addr,
+                         uint8_t *packet)
+{
+  pc_header_t header = P2G4_MSG_TXRX;
+  struct iovec iov[4];
+  int n = 0;
+
+  p2G4_dev_rx_start_i(io);
+  io->rx_resp_type = s->rx.resp_type;
+  iov[n].iov_base = &header;
+  iov[n++].iov_len = sizeof(header);
+  iov[n].iov_base = s;
+  iov[n++].iov_len = sizeof(p2G4_txrx_t);
+  if (s->rx.n_addr > 0) {
+    iov[n].iov_base = phy_addr;
+    iov[n++].iov_len = sizeof(p2G4_address_t)*s->rx.n_addr;
+  }
+  if (s->tx.packet_size > 0) {
+    iov[n].iov_base = packet;
+    iov[n++].iov_len = s->tx.packet_size;
+  }
+  p2G4_dev_sendv_i(io, iov, n);
+}
+
+void p2G4_dev_req_rx_autoresp_i(p2G4_dev_io_t *io, p2G4_rx_autoresp_t *s,
+                                p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules,
+                                uint8_t *packet)
 {
-  pb_send_msg(pb_dev_state->ff_dtp, P2G4_MSG_TXV2, (void *)s, sizeof(p2G4_txv2_t));
-  pb_send_payload(pb_dev_state->ff_dtp, buf, s->packet_size);
+  pc_header_t header = P2G4_MSG_RX_AUTORESP;
+  struct iovec iov[5];
+  int n = 0;
+
+  if (s->n_rules > P2G4_RX_FILTER_MAX_RULES) {
+    bs_trace_error_line("Too many auto response condition rules (%u > %u)\n",
+                        s->n_rules, P2G4_RX_FILTER_MAX_RULES);
+  }
+
+  p2G4_dev_rx_start_i(io);
+  io->rx_resp_type = s->rx.resp_type;
+  iov[n].iov_base = &header;
+  iov[n++].iov_len = sizeof(header);
+  iov[n].iov_base = s;
+  iov[n++].iov_len = sizeof(p2G4_rx_autoresp_t);
+  if (s->rx.n_addr > 0) {
+    iov[n].iov_base = phy_addr;
+    iov[n++].iov_len = sizeof(p2G4_address_t)*s->rx.n_addr;
+  }
+  if (s->n_rules > 0) {
+    iov[n].iov_base = rules;
+    iov[n++].iov_len = sizeof(p2G4_rx_filter_rule_t)*s->n_rules;
+  }
+  if (s->tx.packet_size > 0) {
+    iov[n].iov_base = packet;
+    iov[n++].iov_len = s->tx.packet_size;
+  }
+  p2G4_dev_sendv_i(io, iov, n);
 }
 
-void p2G4_dev_req_tx2v1_i(pb_dev_state_t *pb_dev_state, p2G4_tx2v1_t *s, uint8_t *buf)
+void p2G4_dev_req_cca_tx_i(p2G4_dev_io_t *io, p2G4_cca_tx_t *s, uint32_t *backoffs,
+                           uint8_t *packet)
 {
-  pb_send_msg(pb_dev_state->ff_dtp, P2G4_MSG_TX2V1, (void *)s, sizeof(p2G4_tx2v1_t));
-  pb_send_payload(pb_dev_state->ff_dtp, buf, s->packet_size);
+  pc_header_t header = P2G4_MSG_CCA_TX;
+  struct iovec iov[4];
+  int n = 0;
+
+  if (s->n_backoffs > P2G4_CCA_TX_MAX_BACKOFFS) {
+    bs_trace_error_line("Too many CCA backoffs (%u > %u)\n",
+                        s->n_backoffs, P2G4_CCA_TX_MAX_BACKOFFS);
+  }
+
+  iov[n].iov_base = &header;
+  iov[n++].iov_len = sizeof(header);
+  iov[n].iov_base = s;
+  iov[n++].iov_len = sizeof(p2G4_cca_tx_t);
+  if (s->n_backoffs > 0) {
+    iov[n].iov_base = backoffs;
+    iov[n++].iov_len = sizeof(uint32_t)*s->n_backoffs;
+  }
+  if (s->tx.packet_size > 0) {
+    iov[n].iov_base = packet;
+    iov[n++].iov_len = s->tx.packet_size;
+  }
+  p2G4_dev_sendv_i(io, iov, n);
 }
 
-int p2G4_dev_handle_tx_resp_i(pb_dev_state_t *pb_dev_state, pc_header_t header,
+int p2G4_dev_handle_tx_resp_i(p2G4_dev_io_t *io, pc_header_t header,
                               p2G4_tx_done_t *tx_done_s)
 {
   int ret;
   if (header == P2G4_MSG_TX_END) {
-    ret = pb_dev_read(pb_dev_state, tx_done_s, sizeof(p2G4_tx_done_t));
+    ret = p2G4_dev_read_i(io, tx_done_s, sizeof(p2G4_tx_done_t));
     if (ret == -1)
       return -1;
     else
       return 0;
   } else if (header == PB_MSG_DISCONNECT) {
-    pb_dev_clean_up(pb_dev_state);
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else {
+    INVALID_RESP(header);
+    return -1;
+  }
+}
+
+int p2G4_dev_handle_tx_chain_resp_i(p2G4_dev_io_t *io, pc_header_t header,
+                                    p2G4_tx_chain_done_t *done_s)
+{
+  if (header == P2G4_MSG_TX_CHAIN_END) {
+    return p2G4_dev_read_i(io, done_s, sizeof(p2G4_tx_chain_done_t));
+  } else if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else {
+    INVALID_RESP(header);
+    return -1;
+  }
+}
+
+int p2G4_dev_handle_cca_tx_resp_i(p2G4_dev_io_t *io, pc_header_t header,
+                                  p2G4_cca_tx_done_t *done_s)
+{
+  if (header == P2G4_MSG_CCA_TX_END) {
+    return p2G4_dev_read_i(io, done_s, sizeof(p2G4_cca_tx_done_t));
+  } else if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
     return -1;
   } else {
     INVALID_RESP(header);
@@ -50,33 +1164,33 @@ int p2G4_dev_handle_tx_resp_i(pb_dev_state_t *pb_dev_state, pc_header_t header,
   }
 }
 
-int p2G4_dev_get_tx_resp_i(pb_dev_state_t *pb_dev_state,
+int p2G4_dev_get_tx_resp_i(p2G4_dev_io_t *io,
                            p2G4_tx_done_t *tx_done_s)
 {
   pc_header_t header;
   int ret;
 
-  ret = pb_dev_read(pb_dev_state, &header, sizeof(header));
+  ret = p2G4_dev_read_header_i(io, &header);
   if (ret == -1)
     return -1;
 
-  ret = p2G4_dev_handle_tx_resp_i(pb_dev_state, header,
+  ret = p2G4_dev_handle_tx_resp_i(io, header,
                                   tx_done_s);
   return ret;
 }
 
-int p2G4_dev_handle_cca_resp_i(pb_dev_state_t *pb_dev_state, pc_header_t header,
+int p2G4_dev_handle_cca_resp_i(p2G4_dev_io_t *io, pc_header_t header,
                               p2G4_cca_done_t *cca_done_s)
 {
   int ret;
   if (header == P2G4_MSG_CCA_END) {
-    ret = pb_dev_read(pb_dev_state, cca_done_s, sizeof(p2G4_cca_done_t));
+    ret = p2G4_dev_read_i(io, cca_done_s, sizeof(p2G4_cca_done_t));
     if (ret == -1)
       return -1;
     else
       return 0;
   } else if (header == PB_MSG_DISCONNECT) {
-    pb_dev_clean_up(pb_dev_state);
+    p2G4_dev_clean_up_i(io);
     return -1;
   } else {
     INVALID_RESP(header);
@@ -84,21 +1198,54 @@ int p2G4_dev_handle_cca_resp_i(pb_dev_state_t *pb_dev_state, pc_header_t header,
   }
 }
 
-int p2G4_dev_get_rssi_resp_i(pb_dev_state_t *pb_dev_state,
+void p2G4_dev_req_cca_multi_i(p2G4_dev_io_t *io, p2G4_cca_multi_t *s, p2G4_freq2_t *freqs)
+{
+  if ((s->n_freqs == 0) || (s->n_freqs > P2G4_CCA_MULTI_MAX_FREQS)) {
+    bs_trace_error_line("Multi-frequency CCA n_freqs (%u) must be 1..%u\n",
+                        s->n_freqs, P2G4_CCA_MULTI_MAX_FREQS);
+  }
+  p2G4_dev_send_msg_payload_i(io, P2G4_MSG_CCA_MULTI,
+                              s, sizeof(p2G4_cca_multi_t),
+                              freqs, s->n_freqs*sizeof(p2G4_freq2_t));
+}
+
+int p2G4_dev_handle_cca_multi_resp_i(p2G4_dev_io_t *io, pc_header_t header,
+                                     p2G4_cca_done_t *done_s, uint n_freqs)
+{
+  if (header == P2G4_MSG_CCA_MULTI_END) {
+    return p2G4_dev_read_i(io, done_s, n_freqs*sizeof(p2G4_cca_done_t));
+  } else if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else {
+    INVALID_RESP(header);
+    return -1;
+  }
+}
+
+int p2G4_dev_get_rssi_resp_i(p2G4_dev_io_t *io,
                              p2G4_rssi_done_t *RSSI_done_s)
 {
   pc_header_t header;
   int ret;
 
-  ret = pb_dev_read(pb_dev_state, &header, sizeof(header));
+  ret = p2G4_dev_read_header_i(io, &header);
   if (ret == -1)
       return -1;
 
+  return p2G4_dev_handle_rssi_resp_i(io, header, RSSI_done_s);
+}
+
+int p2G4_dev_handle_rssi_resp_i(p2G4_dev_io_t *io, pc_header_t header,
+                                p2G4_rssi_done_t *RSSI_done_s)
+{
+  int ret;
+
   if (header == PB_MSG_DISCONNECT) {
-    pb_dev_clean_up(pb_dev_state);
+    p2G4_dev_clean_up_i(io);
     return -1;
   } else if ((header == P2G4_MSG_RSSI_END) || (header == P2G4_MSG_IMMRSSI_RRSI_DONE)) {
-    ret = pb_dev_read(pb_dev_state, RSSI_done_s, sizeof(p2G4_rssi_done_t));
+    ret = p2G4_dev_read_i(io, RSSI_done_s, sizeof(p2G4_rssi_done_t));
     if (ret == -1)
       return -1;
     else
@@ -109,11 +1256,221 @@ int p2G4_dev_get_rssi_resp_i(pb_dev_state_t *pb_dev_state,
   }
 }
 
-int p2G4_rx_pick_packet(pb_dev_state_t *pb_dev_state, size_t rx_size,
+void p2G4_dev_req_rssi_sweep_i(p2G4_dev_io_t *io, p2G4_rssi_sweep_t *s,
+                               p2G4_freq2_t *freqs)
+{
+  if ((s->n_points == 0) || (s->n_points > P2G4_RSSI_SWEEP_MAX_POINTS)) {
+    bs_trace_error_line("RSSI sweep n_points (%u) must be 1..%u\n",
+                        s->n_points, P2G4_RSSI_SWEEP_MAX_POINTS);
+  }
+  if ((s->n_freqs != 0) && (s->n_freqs != s->n_points)) {
+    bs_trace_error_line("RSSI sweep n_freqs (%u) must be 0 or n_points (%u)\n",
+                        s->n_freqs, s->n_points);
+  }
+  p2G4_dev_send_msg_payload_i(io, P2G4_MSG_RSSI_SWEEP,
+                              s, sizeof(p2G4_rssi_sweep_t),
+                              freqs, s->n_freqs*sizeof(p2G4_freq2_t));
+}
+
+int p2G4_dev_handle_rssi_sweep_resp_i(p2G4_dev_io_t *io, pc_header_t header,
+                                      p2G4_rssi_power_t *rssi, uint n_points)
+{
+  if (header == P2G4_MSG_RSSI_SWEEP_END) {
+    return p2G4_dev_read_i(io, rssi, n_points*sizeof(p2G4_rssi_power_t));
+  } else if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else {
+    INVALID_RESP(header);
+    return -1;
+  }
+}
+
+int p2G4_dev_get_rssi_sweep_resp_i(p2G4_dev_io_t *io,
+                                   p2G4_rssi_power_t *rssi, uint n_points)
+{
+  pc_header_t header;
+
+  if (p2G4_dev_read_header_i(io, &header) == -1) {
+    return -1;
+  }
+  return p2G4_dev_handle_rssi_sweep_resp_i(io, header, rssi, n_points);
+}
+
+/**
+ * Read the p2G4_rxv2_done_t of a P2G4_MSG_RXV2_END, and if the phy accepted
+ * the packet on its own (see P2G4_MSG_RX_FILTER), the packet which follows it
+ * got_address shall be true if the device already got a
+ * P2G4_MSG_RXV2_ADDRESSFOUND for this reception
+ */
+int p2G4_dev_read_rxv2_end_i(p2G4_dev_io_t *io, p2G4_rxv2_done_t *rx_done_s,
+                             bool got_address, uint8_t **rx_buf, size_t buf_size)
+{
+  if (p2G4_dev_read_i(io, rx_done_s, sizeof(p2G4_rxv2_done_t)) == -1) {
+    return -1;
+  }
+  if ((got_address == false) && io->rx_end_payload) {
+    return p2G4_rx_pick_packet(io, rx_done_s->packet_size, rx_buf, buf_size);
+  }
+  return 0;
+}
+
+/**
+ * Handle the response to a P2G4_MSG_RX_CHAIN: read the p2G4_rx_chain_done_t
+ * and the payload of all segments into one buffer
+ */
+int p2G4_dev_handle_rx_chain_resp_i(p2G4_dev_io_t *io, pc_header_t header,
+                                    p2G4_rx_chain_done_t *done_s,
+                                    uint8_t **rx_buf, size_t buf_size)
+{
+  if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else if (header != P2G4_MSG_RX_CHAIN_END) {
+    INVALID_RESP(header);
+    return -1;
+  }
+  if (p2G4_dev_read_i(io, done_s, sizeof(p2G4_rx_chain_done_t)) == -1) {
+    return -1;
+  }
+  return p2G4_rx_pick_packet(io, done_s->rx.packet_size, rx_buf, buf_size);
+}
+
+void p2G4_dev_req_rx_multi_i(p2G4_dev_io_t *io, p2G4_rx_multi_t *s, p2G4_rx2v1_t *rxs,
+                             p2G4_address_t *phy_addr)
+{
+  pc_header_t header = P2G4_MSG_RX_MULTI;
+  struct iovec iov[4];
+  int n = 0;
+  uint n_addr = 0;
+
+  if ((s->n_rx == 0) || (s->n_rx > P2G4_RX_MULTI_MAX_RX)) {
+    bs_trace_error_line("Multi-receiver Rx n_rx (%u) must be 1..%u\n",
+                        s->n_rx, P2G4_RX_MULTI_MAX_RX);
+  }
+  for (uint i = 0; i < s->n_rx; i++) {
+    if (rxs[i].resp_type != rxs[0].resp_type) {
+      bs_trace_error_line("All receivers of a multi-receiver Rx must have the same resp_type\n");
+    }
+    n_addr += rxs[i].n_addr;
+  }
+  if ((rxs[0].resp_type & P2G4_RESP_ERROR_MASK)
+      || ((rxs[0].resp_type & P2G4_RESP_PAYLOAD_MASK) == P2G4_RESP_PAYLOAD_CHUNKED)) {
+    bs_trace_error_line("Error masks and chunked payload delivery are not supported for multi-receiver Rx\n");
+  }
+
+  p2G4_dev_rx_start_i(io);
+  io->rx_resp_type = rxs[0].resp_type;
+  iov[n].iov_base = &header;
+  iov[n++].iov_len = sizeof(header);
+  iov[n].iov_base = s;
+  iov[n++].iov_len = sizeof(p2G4_rx_multi_t);
+  iov[n].iov_base = rxs;
+  iov[n++].iov_len = sizeof(p2G4_rx2v1_t)*s->n_rx;
+  if (n_addr > 0) {
+    iov[n].iov_base = phy_addr;
+    iov[n++].iov_len = sizeof(p2G4_address_t)*n_addr;
+  }
+  p2G4_dev_sendv_i(io, iov, n);
+}
+
+/**
+ * Handle a response to a P2G4_MSG_RX_MULTI (other than an abort reevaluation):
+ * tag is updated, and the receiver done structure and packet are copied into
+ * done_s[tag->rx_idx] and rx_bufs[tag->rx_idx]
+ */
+int p2G4_dev_handle_rx_multi_resp_i(p2G4_dev_io_t *io, pc_header_t header,
+                                    p2G4_rx_multi_tag_t *tag, p2G4_rxv2_done_t *done_s,
+                                    uint n_rx, uint8_t **rx_bufs, size_t buf_size)
+{
+  if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else if (header != P2G4_MSG_RX_MULTI_END) {
+    INVALID_RESP(header);
+    return -1;
+  }
+  if (p2G4_dev_read_i(io, tag, sizeof(p2G4_rx_multi_tag_t)) == -1) {
+    return -1;
+  }
+  if (tag->rx_idx >= n_rx) {
+    bs_trace_warning_line("Received a completion for receiver %u of a %u receivers Rx"
+                          " => Disconnecting\n", tag->rx_idx, n_rx);
+    p2G4_dev_disconnect_i(io);
+    return -1;
+  }
+  if (p2G4_dev_read_i(io, &done_s[tag->rx_idx], sizeof(p2G4_rxv2_done_t)) == -1) {
+    return -1;
+  }
+  return p2G4_rx_pick_packet(io, done_s[tag->rx_idx].packet_size,
+                             &rx_bufs[tag->rx_idx], buf_size);
+}
+
+/**
+ * Until a P2G4_MSG_TXRX_END says otherwise, the Tx is expected to be fully
+ * transmitted (the phy does not send it if the device stops the Rx)
+ */
+void p2G4_dev_txrx_tx_done_i(p2G4_txrx_t *s, p2G4_txrx_done_t *done_s)
+{
+  done_s->tx.end_time = s->tx.end_tx_time;
+}
+
+/**
+ * Until a P2G4_MSG_TXRX_END says otherwise, the automatic response is
+ * expected to not be sent (it is not if the device stops the Rx)
+ */
+void p2G4_dev_rx_autoresp_tx_done_i(p2G4_txrx_done_t *done_s)
+{
+  done_s->tx.end_time = TIME_NEVER;
+}
+
+/**
+ * Read the p2G4_txrx_done_t of a P2G4_MSG_TXRX_END, and the packet which
+ * may follow it (see p2G4_dev_read_rxv2_end_i())
+ */
+int p2G4_dev_read_txrx_end_i(p2G4_dev_io_t *io, p2G4_txrx_done_t *done_s,
+                             bool got_address, uint8_t **rx_buf, size_t buf_size)
+{
+  if (p2G4_dev_read_i(io, &done_s->tx, sizeof(p2G4_tx_done_t)) == -1) {
+    return -1;
+  }
+  return p2G4_dev_read_rxv2_end_i(io, &done_s->rx, got_address, rx_buf, buf_size);
+}
+
+int p2G4_rx_pick_packet(p2G4_dev_io_t *io, size_t rx_size,
                         uint8_t **rx_buf, size_t buf_size){
+  size_t to_read = rx_size;
+
+  io->rx_cur_buf = NULL;
+
+  switch (io->rx_resp_type & P2G4_RESP_PAYLOAD_MASK) {
+  case P2G4_RESP_PAYLOAD_NONE:
+    /* Nothing follows, the device may fetch it later */
+    if ((buf_size == 0) || (buf_size == P2G4_RXBUF_FROM_POOL)) {
+      *rx_buf = NULL;
+    }
+    io->rx_cur_buf = NULL;
+    memset(&io->rx_progress, 0, sizeof(p2G4_rx_progress_t));
+    io->rx_progress.first_error = UINT16_MAX;
+    return 0;
+  case P2G4_RESP_PAYLOAD_HEADER:
+  case P2G4_RESP_PAYLOAD_CHUNKED:
+    /* Only the header follows, but we get a buffer for the whole packet,
+     * so the device may fetch (or we will get) the rest into it */
+    if (to_read > P2G4_RESP_GET_HEADER_LEN(io->rx_resp_type)) {
+      to_read = P2G4_RESP_GET_HEADER_LEN(io->rx_resp_type);
+    }
+    break;
+  default:
+    break;
+  }
+
   if (rx_size > 0) {
     uint8_t buf_ok = 0;
-    if (rx_size <= buf_size) {
+    if (buf_size == P2G4_RXBUF_FROM_POOL) {
+      *rx_buf = p2G4_rx_pool_acquire(&io->rx_pool, rx_size);
+      buf_ok = 1;
+    } else if (rx_size <= buf_size) {
       buf_ok = 1;
     } else if (buf_size == 0) {
       *rx_buf = bs_malloc(rx_size);
@@ -122,12 +1479,144 @@ int p2G4_rx_pick_packet(pb_dev_state_t *pb_dev_state, size_t rx_size,
     if (buf_ok == 0) {
       bs_trace_warning_line("Too small buffer to pick incoming packet (%i < %i"
                             ") => Disconnecting\n", buf_size, rx_size);
-      pb_dev_disconnect(pb_dev_state);
+      p2G4_dev_disconnect_i(io);
       return -1;
     }
-    if (pb_dev_read(pb_dev_state, *rx_buf, rx_size) == -1) {
+    if (p2G4_dev_read_i(io, *rx_buf, to_read) == -1) {
       return -1;
     }
+    io->rx_cur_buf = *rx_buf;
+    io->rx_cur_size = rx_size;
+  } else if (buf_size == P2G4_RXBUF_FROM_POOL) {
+    /* No packet, but the device may still release "its" buffer as usual */
+    *rx_buf = NULL;
+  }
+  memset(&io->rx_progress, 0, sizeof(p2G4_rx_progress_t));
+  io->rx_progress.received = to_read;
+  io->rx_progress.first_error = UINT16_MAX;
+  return 0;
+}
+
+/**
+ * Handle a P2G4_MSG_RX_CHUNK (after its header has been read):
+ * The chunk is placed in the reception buffer, and the progress updated
+ */
+int p2G4_dev_handle_rx_chunk_i(p2G4_dev_io_t *io)
+{
+  p2G4_rx_chunk_t *chunk = &io->rx_progress.last;
+
+  if (p2G4_dev_read_i(io, chunk, sizeof(p2G4_rx_chunk_t)) == -1) {
+    return -1;
+  }
+  if ((io->rx_cur_buf == NULL)
+      || ((size_t)chunk->offset + chunk->size > io->rx_cur_size)) {
+    bs_trace_warning_line("Received Rx chunk outside of the packet (%u+%u > %u)"
+                          " => Disconnecting\n", chunk->offset, chunk->size,
+                          (uint)io->rx_cur_size);
+    p2G4_dev_disconnect_i(io);
+    return -1;
+  }
+  if (p2G4_dev_read_i(io, io->rx_cur_buf + chunk->offset, chunk->size) == -1) {
+    return -1;
+  }
+  if (chunk->offset + chunk->size > io->rx_progress.received) {
+    io->rx_progress.received = chunk->offset + chunk->size;
+  }
+  if (chunk->bit_errors && (chunk->offset < io->rx_progress.first_error)) {
+    io->rx_progress.first_error = chunk->offset;
   }
   return 0;
 }
+
+/**
+ * Read the next response header from the phy, handling on the way any
+ * P2G4_MSG_RX_CHUNK, P2G4_MSG_RX_ERROR_MASK or P2G4_MSG_RX_RSSI_SAMPLES
+ * (which do not need a device response)
+ * Any posted Tx before is reconciled here: either the phy reports it failed
+ * (P2G4_MSG_TX_POSTED_FAIL) and we disconnect, or it went as expected.
+ * (Not for multiplexed connections, where each message comes with its own tag)
+ */
+int p2G4_dev_read_header_i(p2G4_dev_io_t *io, pc_header_t *header)
+{
+  int ret;
+
+  while (1) {
+    if (p2G4_dev_read_i(io, header, sizeof(pc_header_t)) == -1) {
+      return -1;
+    }
+    if (*header == P2G4_MSG_RX_CHUNK) {
+      ret = p2G4_dev_handle_rx_chunk_i(io);
+    } else if (*header == P2G4_MSG_RX_ERROR_MASK) {
+      ret = p2G4_dev_handle_rx_error_mask_i(io);
+    } else if (*header == P2G4_MSG_RX_RSSI_SAMPLES) {
+      ret = p2G4_dev_handle_rx_rssi_samples_i(io);
+    } else if (*header == P2G4_MSG_TX_POSTED_FAIL) {
+      ret = p2G4_dev_handle_tx_posted_fail_i(io);
+    } else {
+      io->posted_tx = 0;
+      return 0;
+    }
+    if (ret == -1) {
+      return -1;
+    }
+  }
+}
+
+void p2G4_dev_req_rx_payload_i(p2G4_dev_io_t *io, p2G4_rx_payload_t *pl)
+{
+  p2G4_dev_send_msg_i(io, P2G4_MSG_RX_PAYLOAD_REQ, (void *)pl, sizeof(p2G4_rx_payload_t));
+}
+
+/**
+ * Handle the response to a P2G4_MSG_RX_PAYLOAD_REQ:
+ * pl is updated with the part the phy sent, which is copied into buf
+ * (buf must be at least as big as the requested size)
+ */
+int p2G4_dev_handle_rx_payload_resp_i(p2G4_dev_io_t *io, pc_header_t header,
+                                      p2G4_rx_payload_t *pl, uint8_t *buf)
+{
+  size_t req_size = pl->size;
+
+  if (header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(io);
+    return -1;
+  } else if (header != P2G4_MSG_RX_PAYLOAD) {
+    INVALID_RESP(header);
+    return -1;
+  }
+  if (p2G4_dev_read_i(io, pl, sizeof(p2G4_rx_payload_t)) == -1) {
+    return -1;
+  }
+  if (pl->size > req_size) {
+    bs_trace_warning_line("Phy sent more payload than requested (%u > %u)"
+                          " => Disconnecting\n", pl->size, (uint)req_size);
+    p2G4_dev_disconnect_i(io);
+    return -1;
+  }
+  return p2G4_dev_read_i(io, buf, pl->size);
+}
+
+/**
+ * Fetch from the phy <size> bytes of the last received packet, starting at <offset>
+ * into buf
+ *
+ * returns -1 on error, the number of bytes copied otherwise (which may be less
+ * than requested, if the packet is shorter)
+ */
+int p2G4_dev_rx_fetch_payload_i(p2G4_dev_io_t *io, uint16_t offset, uint16_t size,
+                                uint8_t *buf)
+{
+  p2G4_rx_payload_t pl = {.offset = offset, .size = size};
+  pc_header_t header;
+
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+
+  p2G4_dev_req_rx_payload_i(io, &pl);
+  if (p2G4_dev_read_header_i(io, &header) == -1) {
+    return -1;
+  }
+  if (p2G4_dev_handle_rx_payload_resp_i(io, header, &pl, buf) == -1) {
+    return -1;
+  }
+  return pl.size;
+}
@@ -11,20 +11,108 @@
  */
 
 #include "bs_pc_2G4_types.h"
+#include "bs_pc_2G4.h"
 #include "bs_pc_base.h"
+#include <sys/uio.h>
 
 #ifdef __cplusplus
 extern "C"{
 #endif
 
-void p2G4_dev_req_tx_i(pb_dev_state_t *pb_dev_state, p2G4_tx_t *tx_s, uint8_t *p);
-void p2G4_dev_req_txv2_i(pb_dev_state_t *pb_dev_state, p2G4_txv2_t *s, uint8_t *buf);
-void p2G4_dev_req_tx2v1_i(pb_dev_state_t *pb_dev_state, p2G4_tx2v1_t *s, uint8_t *buf);
-int p2G4_dev_handle_tx_resp_i(pb_dev_state_t *pb_dev_state, pc_header_t header, p2G4_tx_done_t *tx_done_s);
-int p2G4_dev_get_tx_resp_i(pb_dev_state_t *pb_dev_state, p2G4_tx_done_t *tx_done_s);
-int p2G4_dev_handle_cca_resp_i(pb_dev_state_t *pb_dev_state, pc_header_t header, p2G4_cca_done_t *cca_done_s);
-int p2G4_dev_get_rssi_resp_i(pb_dev_state_t *pb_dev_state, p2G4_rssi_done_t *RSSI_done_s);
-int p2G4_rx_pick_packet(pb_dev_state_t *pb_dev_state, size_t rx_size, uint8_t **buf, size_t size);
+/* Initial size of the per connection receive buffer */
+#define P2G4_IO_RX_BUF_SIZE 4096
+/* Maximum number of buffers in one frame sent to the phy */
+#define P2G4_IO_MAX_IOV 8
+
+int p2G4_dev_init_com_i(p2G4_dev_io_t *io, pb_dev_state_t *pb_dev_state, uint d, const char* s, const char* p);
+void p2G4_dev_init_mux_i(p2G4_dev_io_t *io, pb_dev_state_t *pb_dev_state, p2G4_mux_t *mux, uint d);
+void p2G4_dev_sendv_i(p2G4_dev_io_t *io, struct iovec *iov, int iovcnt);
+void p2G4_dev_set_req_opt_i(p2G4_dev_io_t *io, p2G4_req_opt_kind_t kind, pc_header_t header, void *buf, size_t size, void *payload, size_t p_size);
+void p2G4_dev_send_msg_payload_i(p2G4_dev_io_t *io, pc_header_t header, void *buf, size_t size, void *payload, size_t p_size);
+void p2G4_dev_send_msg_i(p2G4_dev_io_t *io, pc_header_t header, void *buf, size_t size);
+void p2G4_dev_send_i(p2G4_dev_io_t *io, void *buf, size_t size);
+int p2G4_dev_read_i(p2G4_dev_io_t *io, void *buf, size_t size);
+void *p2G4_dev_read_ref_i(p2G4_dev_io_t *io, size_t size);
+int p2G4_dev_rx_ready_i(p2G4_dev_io_t *io);
+int p2G4_dev_get_fd_i(p2G4_dev_io_t *io);
+void p2G4_dev_clean_up_i(p2G4_dev_io_t *io);
+void p2G4_dev_disconnect_i(p2G4_dev_io_t *io);
+void p2G4_dev_terminate_i(p2G4_dev_io_t *io);
+int p2G4_dev_req_wait_i(p2G4_dev_io_t *io, pb_wait_t *wait_s);
+int p2G4_dev_pick_wait_resp_i(p2G4_dev_io_t *io);
+int p2G4_dev_req_wait_b_i(p2G4_dev_io_t *io, pb_wait_t *wait_s);
+
+int p2G4_dev_set_abort_sched_i(p2G4_dev_io_t *io, p2G4_abort_t *steps, uint n_steps);
+int p2G4_dev_set_rx_filter_i(p2G4_dev_io_t *io, p2G4_rx_filter_t *filter, p2G4_rx_filter_rule_t *rules);
+int p2G4_dev_addr_set_register_i(p2G4_dev_io_t *io, p2G4_address_t *addr, uint32_t n_addr, uint32_t *handle);
+int p2G4_dev_addr_set_release_i(p2G4_dev_io_t *io, uint32_t handle);
+int p2G4_dev_set_rx_addr_set_i(p2G4_dev_io_t *io, uint32_t handle);
+int p2G4_dev_handle_addr_set_resp_i(p2G4_dev_io_t *io, pc_header_t header);
+void p2G4_dev_req_tx_i(p2G4_dev_io_t *io, p2G4_tx_t *tx_s, uint8_t *p);
+void p2G4_dev_req_txv2_i(p2G4_dev_io_t *io, p2G4_txv2_t *s, uint8_t *buf);
+void p2G4_dev_req_tx2v1_i(p2G4_dev_io_t *io, p2G4_tx2v1_t *s, uint8_t *buf);
+bool p2G4_dev_tx2v1_postable_i(p2G4_tx2v1_t *s);
+void p2G4_dev_req_tx2v1_posted_i(p2G4_dev_io_t *io, p2G4_tx2v1_t *s, uint8_t *buf, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_handle_tx_posted_fail_i(p2G4_dev_io_t *io);
+void p2G4_dev_req_tx_chain_i(p2G4_dev_io_t *io, p2G4_tx_chain_t *chain, p2G4_tx2v1_t *segs, uint8_t *packet);
+void p2G4_dev_req_rx_i(p2G4_dev_io_t *io, p2G4_rx_t *s);
+void p2G4_dev_req_rxv2_i(p2G4_dev_io_t *io, p2G4_rxv2_t *s, p2G4_address_t *phy_addr);
+void p2G4_dev_req_rx2v1_i(p2G4_dev_io_t *io, p2G4_rx2v1_t *s, p2G4_address_t *phy_addr);
+void p2G4_dev_req_rx_stream_i(p2G4_dev_io_t *io, p2G4_rx_stream_t *s, p2G4_address_t *phy_addr, p2G4_freq2_t *channels);
+void p2G4_dev_req_rx_chain_i(p2G4_dev_io_t *io, p2G4_rx_chain_t *chain, p2G4_rx2v1_t *s, p2G4_address_t *phy_addr, p2G4_rx_chain_seg_t *segs);
+void p2G4_dev_req_txrx_i(p2G4_dev_io_t *io, p2G4_txrx_t *s, p2G4_address_t *phy_addr, uint8_t *packet);
+void p2G4_dev_req_cca_tx_i(p2G4_dev_io_t *io, p2G4_cca_tx_t *s, uint32_t *backoffs, uint8_t *packet);
+void p2G4_dev_req_rx_autoresp_i(p2G4_dev_io_t *io, p2G4_rx_autoresp_t *s, p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules, uint8_t *packet);
+int p2G4_dev_handle_tx_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_get_tx_resp_i(p2G4_dev_io_t *io, p2G4_tx_done_t *tx_done_s);
+int p2G4_dev_handle_tx_chain_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_tx_chain_done_t *done_s);
+int p2G4_dev_handle_cca_tx_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_cca_tx_done_t *done_s);
+int p2G4_dev_handle_cca_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_cca_done_t *cca_done_s);
+void p2G4_dev_req_cca_multi_i(p2G4_dev_io_t *io, p2G4_cca_multi_t *s, p2G4_freq2_t *freqs);
+int p2G4_dev_handle_cca_multi_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_cca_done_t *done_s, uint n_freqs);
+void p2G4_dev_req_rx_multi_i(p2G4_dev_io_t *io, p2G4_rx_multi_t *s, p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr);
+int p2G4_dev_handle_rx_multi_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_rx_multi_tag_t *tag, p2G4_rxv2_done_t *done_s, uint n_rx, uint8_t **rx_bufs, size_t buf_size);
+int p2G4_dev_get_rssi_resp_i(p2G4_dev_io_t *io, p2G4_rssi_done_t *RSSI_done_s);
+int p2G4_dev_handle_rssi_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_rssi_done_t *RSSI_done_s);
+void p2G4_dev_req_rssi_sweep_i(p2G4_dev_io_t *io, p2G4_rssi_sweep_t *s, p2G4_freq2_t *freqs);
+int p2G4_dev_handle_rssi_sweep_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_rssi_power_t *rssi, uint n_points);
+int p2G4_dev_get_rssi_sweep_resp_i(p2G4_dev_io_t *io, p2G4_rssi_power_t *rssi, uint n_points);
+int p2G4_rx_pick_packet(p2G4_dev_io_t *io, size_t rx_size, uint8_t **buf, size_t size);
+int p2G4_dev_handle_rx_chunk_i(p2G4_dev_io_t *io);
+int p2G4_dev_read_header_i(p2G4_dev_io_t *io, pc_header_t *header);
+int p2G4_dev_read_rxv2_end_i(p2G4_dev_io_t *io, p2G4_rxv2_done_t *rx_done_s, bool got_address, uint8_t **rx_buf, size_t buf_size);
+int p2G4_dev_handle_rx_chain_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_rx_chain_done_t *done_s, uint8_t **rx_buf, size_t buf_size);
+void p2G4_dev_txrx_tx_done_i(p2G4_txrx_t *s, p2G4_txrx_done_t *done_s);
+void p2G4_dev_rx_autoresp_tx_done_i(p2G4_txrx_done_t *done_s);
+int p2G4_dev_read_txrx_end_i(p2G4_dev_io_t *io, p2G4_txrx_done_t *done_s, bool got_address, uint8_t **rx_buf, size_t buf_size);
+void p2G4_dev_req_rx_payload_i(p2G4_dev_io_t *io, p2G4_rx_payload_t *pl);
+int p2G4_dev_handle_rx_payload_resp_i(p2G4_dev_io_t *io, pc_header_t header, p2G4_rx_payload_t *pl, uint8_t *buf);
+int p2G4_dev_rx_fetch_payload_i(p2G4_dev_io_t *io, uint16_t offset, uint16_t size, uint8_t *buf);
+
+int p2G4_dev_async_pick_resp_i(p2G4_dev_state_a_t *p2G4_dev_state);
+
+uint8_t *p2G4_rx_pool_acquire(p2G4_rx_pool_t *pool, size_t size);
+void p2G4_rx_pool_release(p2G4_rx_pool_t *pool, uint8_t *buf);
+void p2G4_rx_pool_get_stats(p2G4_rx_pool_t *pool, p2G4_rx_pool_stats_t *stats);
+void p2G4_rx_pool_free(p2G4_rx_pool_t *pool);
+
+int p2G4_dev_tmpl_register_i(p2G4_dev_io_t *io, pc_header_t req, void *s, p2G4_address_t *phy_addr, uint32_t *handle);
+int p2G4_dev_use_tmpl_i(p2G4_dev_io_t *io, uint32_t handle);
+bool p2G4_dev_send_tmpl_i(p2G4_dev_io_t *io, pc_header_t req, void *s, p2G4_address_t *phy_addr, uint8_t *payload);
+pc_header_t p2G4_tmpl_req_i(p2G4_dev_io_t *io, uint32_t handle);
+void p2G4_tmpl_free(p2G4_dev_io_t *io);
+
+void p2G4_err_mask_reset(p2G4_dev_io_t *io);
+void p2G4_err_mask_free(p2G4_dev_io_t *io);
+int p2G4_dev_handle_rx_error_mask_i(p2G4_dev_io_t *io);
+int p2G4_dev_imm_req_error_mask_i(p2G4_dev_io_t *io, uint32_t start_bit);
+void p2G4_dev_rx_get_error_mask_i(p2G4_dev_io_t *io, p2G4_rx_error_mask_t *mask);
+
+void p2G4_rssi_series_reset(p2G4_dev_io_t *io);
+void p2G4_rssi_series_free(p2G4_dev_io_t *io);
+int p2G4_dev_set_rx_rssi_series_i(p2G4_dev_io_t *io, p2G4_rssi_series_t *series);
+int p2G4_dev_handle_rx_rssi_samples_i(p2G4_dev_io_t *io);
+void p2G4_dev_rx_get_rssi_samples_i(p2G4_dev_io_t *io, p2G4_rx_rssi_samples_t *samples);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * RSSI sampling during a reception (see P2G4_MSG_RX_RSSI_SERIES and
+ * P2G4_MSG_RX_RSSI_SAMPLES)
+ *
+ * The device asks for it with an Rx request (in its same frame), and the phy
+ * sends all the samples taken in one message right before that reception ends.
+ * The library keeps the samples of the last reception.
+ */
+
+#include <stdlib.h>
+#include "bs_tracing.h"
+#include "bs_oswrap.h"
+#include "bs_pc_2G4_priv.h"
+
+/**
+ * Forget the samples of the previous reception (on a new Rx request)
+ */
+void p2G4_rssi_series_reset(p2G4_dev_io_t *io) {
+  io->rx_rssi_n = 0;
+  io->rx_rssi_start = 0;
+  io->rx_rssi_period = 0;
+}
+
+/**
+ * Free the samples storage of this connection
+ */
+void p2G4_rssi_series_free(p2G4_dev_io_t *io) {
+  free(io->rx_rssi_samples);
+  io->rx_rssi_samples = NULL;
+  io->rx_rssi_max = 0;
+  p2G4_rssi_series_reset(io);
+}
+
+int p2G4_dev_set_rx_rssi_series_i(p2G4_dev_io_t *io, p2G4_rssi_series_t *series) {
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+  if ((series->n_samples == 0)
+      || (series->n_samples > P2G4_RSSI_SERIES_MAX_SAMPLES)) {
+    bs_trace_error_line("RSSI series n_samples (%u) must be 1..%u\n",
+                        series->n_samples, P2G4_RSSI_SERIES_MAX_SAMPLES);
+  }
+  p2G4_dev_set_req_opt_i(io, P2G4_REQ_OPT_RX_RSSI_SERIES, P2G4_MSG_RX_RSSI_SERIES,
+                         series, sizeof(p2G4_rssi_series_t), NULL, 0);
+  return 0;
+}
+
+/**
+ * Handle a P2G4_MSG_RX_RSSI_SAMPLES (after its header has been read)
+ */
+int p2G4_dev_handle_rx_rssi_samples_i(p2G4_dev_io_t *io) {
+  p2G4_rssi_series_done_t done;
+
+  if (p2G4_dev_read_i(io, &done, sizeof(p2G4_rssi_series_done_t)) == -1) {
+    return -1;
+  }
+  if (done.n_samples > P2G4_RSSI_SERIES_MAX_SAMPLES) {
+    bs_trace_warning_line("Received too many RSSI samples (%u)"
+                          " => Disconnecting\n", done.n_samples);
+    p2G4_dev_disconnect_i(io);
+    return -1;
+  }
+
+  if (done.n_samples > io->rx_rssi_max) {
+    io->rx_rssi_max = done.n_samples;
+    io->rx_rssi_samples = bs_realloc(io->rx_rssi_samples,
+                                     io->rx_rssi_max*sizeof(p2G4_rssi_power_t));
+  }
+  if (p2G4_dev_read_i(io, io->rx_rssi_samples,
+                      done.n_samples*sizeof(p2G4_rssi_power_t)) == -1) {
+    return -1;
+  }
+  io->rx_rssi_n = done.n_samples;
+  io->rx_rssi_start = done.start_time;
+  io->rx_rssi_period = done.period;
+  return 0;
+}
+
+void p2G4_dev_rx_get_rssi_samples_i(p2G4_dev_io_t *io, p2G4_rx_rssi_samples_t *samples) {
+  samples->samples = io->rx_rssi_samples;
+  samples->n_samples = io->rx_rssi_n;
+  samples->start_time = io->rx_rssi_start;
+  samples->period = io->rx_rssi_period;
+}
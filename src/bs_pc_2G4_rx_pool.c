@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Per connection pool of reception buffers
+ *
+ * When a device requests a reception with buf_size = P2G4_RXBUF_FROM_POOL,
+ * the received packet is placed in a buffer taken from this pool instead of
+ * a newly malloc'ed one. The device gives it back with
+ * p2G4_dev_rx_pool_release_*() when done with it.
+ *
+ * All buffers in the pool have the same size, the biggest packet_size seen so
+ * far in this connection. So after a few receptions, no more allocations
+ * are needed.
+ */
+
+#include <stdlib.h>
+#include "bs_tracing.h"
+#include "bs_oswrap.h"
+#include "bs_pc_2G4_priv.h"
+
+/* Every buffer is preceded by this header */
+typedef union p2G4_rx_pool_hdr {
+  struct {
+    union p2G4_rx_pool_hdr *next;
+    size_t size;
+  } s;
+  uint64_t align[2];
+} p2G4_rx_pool_hdr_t;
+
+#define P2G4_RX_POOL_GRANULARITY 64
+
+static p2G4_rx_pool_hdr_t *buf_to_hdr(uint8_t *buf) {
+  return ((p2G4_rx_pool_hdr_t *)buf) - 1;
+}
+
+/**
+ * Get a buffer of at least <size> bytes from the pool
+ */
+uint8_t *p2G4_rx_pool_acquire(p2G4_rx_pool_t *pool, size_t size) {
+  p2G4_rx_pool_hdr_t *hdr;
+
+  if (size > pool->buf_size) {
+    pool->buf_size = (size + P2G4_RX_POOL_GRANULARITY - 1)
+                     & ~(size_t)(P2G4_RX_POOL_GRANULARITY - 1);
+  }
+
+  while (pool->free_list != NULL) {
+    hdr = pool->free_list;
+    pool->free_list = hdr->s.next;
+    pool->n_free--;
+    if (hdr->s.size >= pool->buf_size) {
+      pool->hits++;
+      return (uint8_t *)(hdr + 1);
+    }
+    free(hdr); /* From before we saw a bigger packet */
+  }
+
+  pool->misses++;
+  hdr = bs_malloc(sizeof(p2G4_rx_pool_hdr_t) + pool->buf_size);
+  hdr->s.size = pool->buf_size;
+  return (uint8_t *)(hdr + 1);
+}
+
+/**
+ * Give back to the pool a buffer obtained with p2G4_rx_pool_acquire()
+ */
+void p2G4_rx_pool_release(p2G4_rx_pool_t *pool, uint8_t *buf) {
+  p2G4_rx_pool_hdr_t *hdr;
+
+  if (buf == NULL) {
+    return;
+  }
+  hdr = buf_to_hdr(buf);
+  if (hdr->s.size < pool->buf_size) {
+    free(hdr);
+    return;
+  }
+  hdr->s.next = pool->free_list;
+  pool->free_list = hdr;
+  pool->n_free++;
+}
+
+void p2G4_rx_pool_get_stats(p2G4_rx_pool_t *pool, p2G4_rx_pool_stats_t *stats) {
+  stats->hits = pool->hits;
+  stats->misses = pool->misses;
+  stats->buf_size = pool->buf_size;
+  stats->n_free = pool->n_free;
+}
+
+/**
+ * Free all the buffers currently in the pool, and report its statistics
+ * (Buffers still held by the device are not affected, and may still be released)
+ */
+void p2G4_rx_pool_free(p2G4_rx_pool_t *pool) {
+  if (pool->hits + pool->misses > 0) {
+    bs_trace_raw(9, "Rx buffer pool: %llu hits, %llu misses (buffer size %u)\n",
+                 (unsigned long long)pool->hits,
+                 (unsigned long long)pool->misses,
+                 (unsigned int)pool->buf_size);
+  }
+  while (pool->free_list != NULL) {
+    p2G4_rx_pool_hdr_t *hdr = pool->free_list;
+    pool->free_list = hdr->s.next;
+    free(hdr);
+  }
+  pool->n_free = 0;
+}
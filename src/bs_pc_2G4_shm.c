@@ -0,0 +1,403 @@
+/*
+ * Copyright 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#define _DEFAULT_SOURCE /* For syscall() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "bs_tracing.h"
+#include "bs_oswrap.h"
+#include "bs_pc_2G4_shm.h"
+
+/*
+ * How many times we poll the ring before going to sleep in the futex.
+ * Spinning only pays off if both sides run in parallel on different cores,
+ * otherwise it just burns the CPU the other side needs, so by default we do not.
+ * It can be set at build time (for ex. -DP2G4_SHM_SPIN_COUNT=2000)
+ */
+#ifndef P2G4_SHM_SPIN_COUNT
+#define P2G4_SHM_SPIN_COUNT 0
+#endif
+/* How long we sleep at most before checking if the other side is still there */
+#define P2G4_SHM_ALIVE_CHECK_NS 200000000
+
+/**
+ * Get the name of the shared memory object for a given device
+ */
+void p2G4_shm_name(char *name, size_t size, uint dev_nbr,
+                   const char *s_id, const char *p_id) {
+  snprintf(name, size, "/bs_%u_%s_%s_2G4.d%u", (unsigned int)getuid(),
+           s_id, p_id, dev_nbr);
+}
+
+/**
+ * Size of the whole shared memory object for a given ring size
+ */
+size_t p2G4_shm_map_size(uint32_t ring_size) {
+  return sizeof(p2G4_shm_header_t) + 2*(size_t)ring_size;
+}
+
+/**
+ * Set up the Tx and Rx ports of <shm> for its mapped header
+ * depending on which side (phy or device) we are
+ */
+void p2G4_shm_set_ports(p2G4_shm_t *shm, int is_phy, int alive_fd) {
+  p2G4_shm_header_t *h = shm->header;
+  uint8_t *dtp_data = (uint8_t *)h + sizeof(p2G4_shm_header_t);
+  uint8_t *ptd_data = dtp_data + h->ring_size;
+
+  if (is_phy) {
+    shm->tx.ring = &h->ptd;
+    shm->tx.data = ptd_data;
+    shm->rx.ring = &h->dtp;
+    shm->rx.data = dtp_data;
+  } else {
+    shm->tx.ring = &h->dtp;
+    shm->tx.data = dtp_data;
+    shm->rx.ring = &h->ptd;
+    shm->rx.data = ptd_data;
+  }
+  shm->tx.size = h->ring_size;
+  shm->rx.size = h->ring_size;
+  shm->tx.alive_fd = alive_fd;
+  shm->rx.alive_fd = alive_fd;
+}
+
+static void futex_wake(uint32_t *word) {
+  syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+/*
+ * Check if the other side is still there (its end of the FIFO is still open)
+ * Returns 0 if it is, -1 otherwise
+ */
+static int other_side_alive(int alive_fd) {
+  struct pollfd pfd = {.fd = alive_fd, .events = 0, .revents = 0};
+
+  if (poll(&pfd, 1, 0) > 0) {
+    if (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Block until *word != old_val
+ * Returns 0 when it changed, -1 if the other side disappeared meanwhile
+ */
+static int wait_for_change(uint32_t *word, uint32_t old_val,
+                           uint32_t *waiting_flag, int alive_fd) {
+  struct timespec timeout = {.tv_sec = 0, .tv_nsec = P2G4_SHM_ALIVE_CHECK_NS};
+
+  for (int i = 0; i < P2G4_SHM_SPIN_COUNT; i++) {
+    if (__atomic_load_n(word, __ATOMIC_ACQUIRE) != old_val) {
+      return 0;
+    }
+  }
+
+  while (1) {
+    __atomic_store_n(waiting_flag, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(word, __ATOMIC_SEQ_CST) != old_val) {
+      break;
+    }
+    syscall(SYS_futex, word, FUTEX_WAIT, old_val, &timeout, NULL, 0);
+    if (__atomic_load_n(word, __ATOMIC_ACQUIRE) != old_val) {
+      break;
+    }
+    if (other_side_alive(alive_fd) != 0) {
+      __atomic_store_n(waiting_flag, 0, __ATOMIC_RELAXED);
+      return -1;
+    }
+  }
+  __atomic_store_n(waiting_flag, 0, __ATOMIC_RELAXED);
+  return 0;
+}
+
+/*
+ * Make the data written so far visible to the reader, and wake it if needed
+ */
+static void publish_wr(p2G4_shm_ring_t *ring, uint32_t wr) {
+  if (ring->wr_idx == wr) {
+    return;
+  }
+  __atomic_store_n(&ring->wr_idx, wr, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&ring->rd_waiting, __ATOMIC_SEQ_CST)) {
+    futex_wake(&ring->wr_idx);
+  }
+}
+
+/**
+ * Write the <iovcnt> buffers described by <iov> into the port ring,
+ * blocking while there is not enough space in it.
+ * The other side is only notified once all has been written
+ * (or when the ring is full)
+ *
+ * Returns 0 on success, -1 if the other side is gone
+ */
+int p2G4_shm_writev(p2G4_shm_port_t *port, const struct iovec *iov, int iovcnt) {
+  p2G4_shm_ring_t *ring = port->ring;
+  uint32_t wr = ring->wr_idx; /* We are the only writer of wr_idx */
+
+  for (int i = 0; i < iovcnt; i++) {
+    const uint8_t *src = (const uint8_t *)iov[i].iov_base;
+    size_t size = iov[i].iov_len;
+
+    while (size > 0) {
+      uint32_t rd = __atomic_load_n(&ring->rd_idx, __ATOMIC_ACQUIRE);
+      uint32_t space = port->size - (wr - rd);
+
+      if (space == 0) {
+        publish_wr(ring, wr);
+        if (wait_for_change(&ring->rd_idx, rd, &ring->wr_waiting,
+                            port->alive_fd) != 0) {
+          return -1;
+        }
+        continue;
+      }
+
+      uint32_t offset = wr & (port->size - 1);
+      uint32_t chunk = space;
+      if (chunk > size) {
+        chunk = size;
+      }
+      if (chunk > port->size - offset) { /* Wrap around */
+        chunk = port->size - offset;
+      }
+      memcpy(&port->data[offset], src, chunk);
+
+      wr += chunk;
+      src += chunk;
+      size -= chunk;
+    }
+  }
+  publish_wr(ring, wr);
+  return 0;
+}
+
+/**
+ * Write <size> bytes from <buf> into the port ring,
+ * blocking while there is not enough space in it
+ *
+ * Returns 0 on success, -1 if the other side is gone
+ */
+int p2G4_shm_write(p2G4_shm_port_t *port, const void *buf, size_t size) {
+  struct iovec iov = {.iov_base = (void *)buf, .iov_len = size};
+
+  return p2G4_shm_writev(port, &iov, 1);
+}
+
+/**
+ * Read from the port ring into <buf> at least <min> bytes, and at most <max>
+ * (as many as are available), blocking until at least <min> are there
+ *
+ * Returns the number of bytes read, or -1 if the other side is gone
+ */
+ssize_t p2G4_shm_read_some(p2G4_shm_port_t *port, void *buf, size_t min, size_t max) {
+  p2G4_shm_ring_t *ring = port->ring;
+  uint8_t *dst = (uint8_t *)buf;
+  uint32_t rd = ring->rd_idx; /* We are the only writer of rd_idx */
+  size_t done = 0;
+
+  while (done < max) {
+    uint32_t wr = __atomic_load_n(&ring->wr_idx, __ATOMIC_ACQUIRE);
+    uint32_t avail = wr - rd;
+
+    if (avail == 0) {
+      if (done >= min) {
+        break;
+      }
+      if (wait_for_change(&ring->wr_idx, wr, &ring->rd_waiting,
+                          port->alive_fd) != 0) {
+        return -1;
+      }
+      continue;
+    }
+
+    uint32_t offset = rd & (port->size - 1);
+    size_t chunk = avail;
+    if (chunk > max - done) {
+      chunk = max - done;
+    }
+    if (chunk > port->size - offset) { /* Wrap around */
+      chunk = port->size - offset;
+    }
+    memcpy(&dst[done], &port->data[offset], chunk);
+
+    rd += chunk;
+    done += chunk;
+    __atomic_store_n(&ring->rd_idx, rd, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ring->wr_waiting, __ATOMIC_SEQ_CST)) {
+      futex_wake(&ring->rd_idx);
+    }
+  }
+  return done;
+}
+
+/**
+ * Read <size> bytes from the port ring into <buf>,
+ * blocking until they are available
+ *
+ * Returns 0 on success, -1 if the other side is gone
+ */
+int p2G4_shm_read(p2G4_shm_port_t *port, void *buf, size_t size) {
+  if (p2G4_shm_read_some(port, buf, size, size) < 0) {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * Returns how many bytes are available to be read from the port ring (without blocking)
+ */
+size_t p2G4_shm_available(p2G4_shm_port_t *port) {
+  return __atomic_load_n(&port->ring->wr_idx, __ATOMIC_ACQUIRE) - port->ring->rd_idx;
+}
+
+/**
+ * Attempt to attach (device side) to the shared memory object the phy
+ * created for this device.
+ *
+ * Returns NULL if the phy did not create it (or it is not usable), in which
+ * case the device shall just continue using the FIFOs.
+ */
+p2G4_shm_t *p2G4_shm_dev_attach(uint dev_nbr, const char *s_id,
+                                const char *p_id, int alive_fd) {
+  char name[256];
+  struct stat st;
+  p2G4_shm_header_t *header;
+  int fd;
+
+  p2G4_shm_name(name, sizeof(name), dev_nbr, s_id, p_id);
+
+  fd = shm_open(name, O_RDWR, 0);
+  if (fd == -1) {
+    return NULL;
+  }
+  if ((fstat(fd, &st) != 0) || (st.st_size < (off_t)sizeof(p2G4_shm_header_t))) {
+    close(fd);
+    return NULL;
+  }
+
+  header = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (header == MAP_FAILED) {
+    return NULL;
+  }
+
+  if ((header->magic != P2G4_SHM_MAGIC)
+      || (header->version != P2G4_SHM_VERSION)
+      || (header->ring_size == 0)
+      || ((header->ring_size & (header->ring_size - 1)) != 0)
+      || ((size_t)st.st_size < p2G4_shm_map_size(header->ring_size))) {
+    bs_trace_warning_line("Found phy shared memory object %s, but it is not "
+                          "compatible (version %u), using the FIFOs instead\n",
+                          name, header->version);
+    munmap(header, st.st_size);
+    return NULL;
+  }
+  if ((kill((pid_t)header->phy_pid, 0) != 0) && (errno == ESRCH)) {
+    bs_trace_warning_line("Found phy shared memory object %s, but it was left "
+                          "behind by a previous simulation, using the FIFOs instead\n",
+                          name);
+    munmap(header, st.st_size);
+    return NULL;
+  }
+
+  p2G4_shm_t *shm = bs_calloc(1, sizeof(p2G4_shm_t));
+  shm->header = header;
+  shm->map_size = st.st_size;
+  p2G4_shm_set_ports(shm, 0, alive_fd);
+
+  return shm;
+}
+
+/**
+ * Create (phy side) the shared memory object for a given device.
+ * This shall be done before the device connects.
+ *
+ * Returns NULL if it could not be created (the phy shall then just use the
+ * FIFOs with this device).
+ * The rings will not be used until the device sends a P2G4_MSG_SHM_ATTACH.
+ * The phy shall then respond thru the FIFO with a P2G4_MSG_SHM_ATTACH_ACK, and
+ * call p2G4_shm_set_ports(shm, 1, <dtp FIFO fd>) (or, if it cannot use it,
+ * respond with a P2G4_MSG_SHM_ATTACH_NACK and continue with the FIFOs)
+ */
+p2G4_shm_t *p2G4_shm_phy_create(uint dev_nbr, const char *s_id,
+                                const char *p_id, uint32_t ring_size) {
+  char name[256];
+  p2G4_shm_header_t *header;
+  size_t map_size = p2G4_shm_map_size(ring_size);
+  int fd;
+
+  if ((ring_size == 0) || ((ring_size & (ring_size - 1)) != 0)) {
+    bs_trace_error_line("The shared memory ring size must be a power of 2 "
+                        "(%u)\n", ring_size);
+  }
+
+  p2G4_shm_name(name, sizeof(name), dev_nbr, s_id, p_id);
+
+  shm_unlink(name); /* In case a previous simulation left it behind */
+  fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  if (fd == -1) {
+    bs_trace_warning_line("Could not create shared memory object %s\n", name);
+    return NULL;
+  }
+  if (ftruncate(fd, map_size) != 0) {
+    close(fd);
+    shm_unlink(name);
+    return NULL;
+  }
+  header = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (header == MAP_FAILED) {
+    shm_unlink(name);
+    return NULL;
+  }
+
+  header->ring_size = ring_size;
+  header->phy_pid = (uint32_t)getpid();
+  header->version = P2G4_SHM_VERSION;
+  __atomic_store_n(&header->magic, P2G4_SHM_MAGIC, __ATOMIC_RELEASE);
+
+  p2G4_shm_t *shm = bs_calloc(1, sizeof(p2G4_shm_t));
+  shm->header = header;
+  shm->map_size = map_size;
+
+  return shm;
+}
+
+/**
+ * Remove (phy side) the shared memory object for a given device
+ * (Mapped memory stays valid until p2G4_shm_detach())
+ */
+void p2G4_shm_phy_unlink(uint dev_nbr, const char *s_id, const char *p_id) {
+  char name[256];
+
+  p2G4_shm_name(name, sizeof(name), dev_nbr, s_id, p_id);
+  shm_unlink(name);
+}
+
+/**
+ * Unmap and free a shared memory transport
+ * (The phy is responsible for unlinking the object itself)
+ */
+void p2G4_shm_detach(p2G4_shm_t *shm) {
+  if (shm == NULL) {
+    return;
+  }
+  munmap(shm->header, shm->map_size);
+  free(shm);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef BS_P2G4_SHM_H
+#define BS_P2G4_SHM_H
+
+/**
+ * Shared memory transport between a device and the 2G4 phy
+ *
+ * Instead of the FIFO pair, a device and the phy may exchange the very same
+ * p2G4_* messages thru a pair of single producer single consumer rings, placed
+ * in a POSIX shared memory object created by the phy.
+ * A futex on each ring write/read index is used as doorbell.
+ *
+ * The phy (if it supports this transport) creates one shared memory object
+ * per device, named as given by p2G4_shm_name(), before the device connects.
+ * The device, after connecting thru the FIFOs, attempts to open it. If it is
+ * there, its version matches, and the phy which created it is still running,
+ * the device sends a P2G4_MSG_SHM_ATTACH thru the FIFO, and waits for the phy
+ * response (also thru the FIFO). Only if it is a P2G4_MSG_SHM_ATTACH_ACK, all
+ * further messages in both directions go thru the rings.
+ * Otherwise the device just continues using the FIFOs.
+ *
+ * The FIFOs are kept open during the whole connection, and are used to
+ * detect if the other side has died.
+ */
+
+#include <sys/uio.h>
+#include "bs_types.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#define P2G4_SHM_MAGIC   0x53324734 /* "4G2S" */
+#define P2G4_SHM_VERSION 2
+
+/* Default size of each ring data area (must be a power of 2) */
+#define P2G4_SHM_DEF_RING_SIZE (64*1024)
+
+typedef struct {
+  /* Number of bytes written into the ring so far (free running)
+   * Only updated by the producer. Used as futex by the consumer */
+  uint32_t wr_idx;
+  /* Set by the consumer while it sleeps waiting for wr_idx to change */
+  uint32_t rd_waiting;
+  uint32_t pad0[14];
+  /* Number of bytes read from the ring so far (free running)
+   * Only updated by the consumer. Used as futex by the producer */
+  uint32_t rd_idx;
+  /* Set by the producer while it sleeps waiting for rd_idx to change */
+  uint32_t wr_waiting;
+  uint32_t pad1[14];
+} p2G4_shm_ring_t;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  /* Size in bytes of each ring data area (a power of 2) */
+  uint32_t ring_size;
+  /* Process id of the phy which created it (to detect objects left behind) */
+  uint32_t phy_pid;
+  uint32_t pad[12];
+  /* Device to phy ring */
+  p2G4_shm_ring_t dtp;
+  /* Phy to device ring */
+  p2G4_shm_ring_t ptd;
+  /* Followed by the dtp ring data, and then the ptd ring data */
+} p2G4_shm_header_t;
+
+typedef struct {
+  p2G4_shm_ring_t *ring;
+  uint8_t *data;
+  uint32_t size;
+  /* FIFO (read end) used to detect if the other side is gone */
+  int alive_fd;
+} p2G4_shm_port_t;
+
+typedef struct p2G4_shm_s {
+  p2G4_shm_header_t *header;
+  size_t map_size;
+  p2G4_shm_port_t tx;
+  p2G4_shm_port_t rx;
+} p2G4_shm_t;
+
+void p2G4_shm_name(char *name, size_t size, uint dev_nbr, const char *s_id, const char *p_id);
+size_t p2G4_shm_map_size(uint32_t ring_size);
+void p2G4_shm_set_ports(p2G4_shm_t *shm, int is_phy, int alive_fd);
+int p2G4_shm_writev(p2G4_shm_port_t *port, const struct iovec *iov, int iovcnt);
+int p2G4_shm_write(p2G4_shm_port_t *port, const void *buf, size_t size);
+ssize_t p2G4_shm_read_some(p2G4_shm_port_t *port, void *buf, size_t min, size_t max);
+int p2G4_shm_read(p2G4_shm_port_t *port, void *buf, size_t size);
+size_t p2G4_shm_available(p2G4_shm_port_t *port);
+
+p2G4_shm_t *p2G4_shm_dev_attach(uint dev_nbr, const char *s_id, const char *p_id, int alive_fd);
+p2G4_shm_t *p2G4_shm_phy_create(uint dev_nbr, const char *s_id, const char *p_id, uint32_t ring_size);
+void p2G4_shm_phy_unlink(uint dev_nbr, const char *s_id, const char *p_id);
+void p2G4_shm_detach(p2G4_shm_t *shm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
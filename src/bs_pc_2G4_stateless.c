@@ -12,21 +12,21 @@
 int p2G4_dev_initcom_s_c(p2G4_dev_state_s_t *p2G4_dev_state, unsigned int dev_nbr,
                          const char* s, const char* p, dev_abort_reeval_f abort_fptr) {
   p2G4_dev_state->abort_f = abort_fptr;
-  return pb_dev_init_com(&p2G4_dev_state->pb_dev_state, dev_nbr, s, p);
+  return p2G4_dev_init_com_i(&p2G4_dev_state->io, &p2G4_dev_state->pb_dev_state, dev_nbr, s, p);
 }
 
 /**
  * Attempt to terminate the simulation
  */
 void p2G4_dev_terminate_s_c(p2G4_dev_state_s_t *p2G4_dev_state){
-  pb_dev_terminate(&p2G4_dev_state->pb_dev_state);
+  p2G4_dev_terminate_i(&p2G4_dev_state->io);
 }
 
 /**
  * Disconnect from the phy
  */
 void p2G4_dev_disconnect_s_c(p2G4_dev_state_s_t *p2G4_dev_state){
-  pb_dev_disconnect(&p2G4_dev_state->pb_dev_state);
+  p2G4_dev_disconnect_i(&p2G4_dev_state->io);
 }
 
 /**
@@ -41,7 +41,7 @@ static int p2G4_dev_do_abort_reeval_s(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_a
   if (p2G4_dev_state->abort_f != NULL) {
     if (p2G4_dev_state->abort_f(abort_s) != 0) {
       bs_trace_warning_line("We (device) are dying in the middle of abort reevaluation!!\n");
-      pb_dev_disconnect(&p2G4_dev_state->pb_dev_state);
+      p2G4_dev_disconnect_i(&p2G4_dev_state->io);
       return -1;
     }
   } else {
@@ -52,8 +52,8 @@ static int p2G4_dev_do_abort_reeval_s(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_a
     abort_s->recheck_time = TIME_NEVER;
   }
 
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp, P2G4_MSG_RERESP_ABORTREEVAL,
-              (void *)abort_s, sizeof(p2G4_abort_t));
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_RERESP_ABORTREEVAL,
+                      (void *)abort_s, sizeof(p2G4_abort_t));
 
   return 0;
 }
@@ -62,7 +62,7 @@ static pc_header_t get_resp_while_handling_abortreeval_s(p2G4_dev_state_s_t *p2G
   pc_header_t header;
   while (1) {
     int ret;
-    ret = pb_dev_read(&p2G4_dev_state->pb_dev_state, &header, sizeof(header));
+    ret = p2G4_dev_read_header_i(&p2G4_dev_state->io, &header);
     if (ret == -1)
         return -1;
 
@@ -88,11 +88,11 @@ int p2G4_dev_req_tx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx_t *tx_s, u
   int ret;
   pc_header_t header;
 
-  p2G4_dev_req_tx_i(&p2G4_dev_state->pb_dev_state, tx_s, packet);
+  p2G4_dev_req_tx_i(&p2G4_dev_state->io, tx_s, packet);
 
   header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &tx_s->abort);
 
-  ret = p2G4_dev_handle_tx_resp_i(&p2G4_dev_state->pb_dev_state, header,
+  ret = p2G4_dev_handle_tx_resp_i(&p2G4_dev_state->io, header,
                                   tx_done_s);
   return ret;
 }
@@ -108,11 +108,11 @@ int p2G4_dev_req_txv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_txv2_t *tx_
   int ret;
   pc_header_t header;
 
-  p2G4_dev_req_txv2_i(&p2G4_dev_state->pb_dev_state, tx_s, packet);
+  p2G4_dev_req_txv2_i(&p2G4_dev_state->io, tx_s, packet);
 
   header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &tx_s->abort);
 
-  ret = p2G4_dev_handle_tx_resp_i(&p2G4_dev_state->pb_dev_state, header,
+  ret = p2G4_dev_handle_tx_resp_i(&p2G4_dev_state->io, header,
                                   tx_done_s);
   return ret;
 }
@@ -128,15 +128,81 @@ int p2G4_dev_req_tx2v1_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx2v1_t *t
   int ret;
   pc_header_t header;
 
-  p2G4_dev_req_tx2v1_i(&p2G4_dev_state->pb_dev_state, tx_s, packet);
+  p2G4_dev_req_tx2v1_i(&p2G4_dev_state->io, tx_s, packet);
 
   header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &tx_s->abort);
 
-  ret = p2G4_dev_handle_tx_resp_i(&p2G4_dev_state->pb_dev_state, header,
+  ret = p2G4_dev_handle_tx_resp_i(&p2G4_dev_state->io, header,
                                   tx_done_s);
   return ret;
 }
 
+/**
+ * Request a transmission (v2.1) to the phy without waiting for its response
+ * ("posted" Tx)
+ *
+ * If the transmission cannot be aborted (abort_time and recheck_time are
+ * TIME_NEVER), its outcome is known in advance: tx_done_s is filled right
+ * away, and the phy will not send a response.
+ * Otherwise this behaves just like p2G4_dev_req_tx2v1_s_c_b()
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_req_tx2v1_posted_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s)
+{
+  if (!p2G4_dev_tx2v1_postable_i(tx_s)) {
+    return p2G4_dev_req_tx2v1_s_c_b(p2G4_dev_state, tx_s, packet, tx_done_s);
+  }
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  p2G4_dev_req_tx2v1_posted_i(&p2G4_dev_state->io, tx_s, packet, tx_done_s);
+  return 0;
+}
+
+/**
+ * Request a chained transmission to the phy: n_segs back to back
+ * segments (for ex. the FEC1 and FEC2 parts of a Coded Phy packet),
+ * handled as one transaction (see p2G4_tx_chain_t)
+ *
+ * packet contains all segments payloads, one after the other
+ * done_s is filled with the status of each segment
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_req_tx_chain_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx_chain_t *chain,
+                                p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s)
+{
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  pc_header_t header;
+
+  p2G4_dev_req_tx_chain_i(&p2G4_dev_state->io, chain, segs, packet);
+
+  header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &chain->abort);
+
+  return p2G4_dev_handle_tx_chain_resp_i(&p2G4_dev_state->io, header, done_s);
+}
+
+/**
+ * Request a CCA followed by a transmission, only if the channel is found clear,
+ * to the phy, as one transaction (see p2G4_cca_tx_t)
+ *
+ * backoffs are the n_backoffs CCA retry backoffs, and packet the Tx payload
+ * done_s is filled with the result of the CCA and the Tx
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_req_cca_tx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_cca_tx_t *cca_tx_s,
+                              uint32_t *backoffs, uint8_t *packet, p2G4_cca_tx_done_t *done_s)
+{
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  pc_header_t header;
+
+  p2G4_dev_req_cca_tx_i(&p2G4_dev_state->io, cca_tx_s, backoffs, packet);
+
+  header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &cca_tx_s->abort);
+
+  return p2G4_dev_handle_cca_tx_resp_i(&p2G4_dev_state->io, header, done_s);
+}
+
 /**
  * Request a transmissions to the phy
  *
@@ -146,7 +212,7 @@ int p2G4_dev_req_tx2v1_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx2v1_t *t
  */
 int p2G4_dev_req_tx_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx_t *tx_s, uint8_t *packet) {
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
-  p2G4_dev_req_tx_i(&p2G4_dev_state->pb_dev_state, tx_s, packet);
+  p2G4_dev_req_tx_i(&p2G4_dev_state->io, tx_s, packet);
   return 0;
 }
 
@@ -159,7 +225,7 @@ int p2G4_dev_req_tx_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx_t *tx_s, uin
  */
 int p2G4_dev_req_txv2_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_txv2_t *tx_s, uint8_t *packet) {
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
-  p2G4_dev_req_txv2_i(&p2G4_dev_state->pb_dev_state, tx_s, packet);
+  p2G4_dev_req_txv2_i(&p2G4_dev_state->io, tx_s, packet);
   return 0;
 }
 
@@ -173,7 +239,7 @@ int p2G4_dev_req_txv2_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_txv2_t *tx_s,
  */
 int p2G4_dev_pick_txresp_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx_done_t *tx_done_s) {
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
-  int ret = p2G4_dev_get_tx_resp_i(&p2G4_dev_state->pb_dev_state, tx_done_s);
+  int ret = p2G4_dev_get_tx_resp_i(&p2G4_dev_state->io, tx_done_s);
   return ret;
 }
 
@@ -186,6 +252,8 @@ int p2G4_dev_pick_txresp_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx_done_
  * This buffer shall have buf_size bytes.
  * If buf_size is 0, this function will allocate a new buffer and point
  *  *rx_buf to it (the application must free it afterwards).
+ * If buf_size is P2G4_RXBUF_FROM_POOL, the buffer will be taken from this
+ * connection pool, and shall be given back with p2G4_dev_rx_pool_release_s_c().
  * Otherwise this function will fail if the buffer is too small to fit
  * the incoming packet
  *
@@ -202,8 +270,7 @@ int p2G4_dev_req_rx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_t *rx_s,
 
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
 
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp,
-              P2G4_MSG_RX, (void *)rx_s, sizeof(p2G4_rx_t));
+  p2G4_dev_req_rx_i(&p2G4_dev_state->io, rx_s);
 
   pc_header_t r_header;
   r_header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &rx_s->abort);
@@ -211,12 +278,12 @@ int p2G4_dev_req_rx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_t *rx_s,
   if (r_header == P2G4_MSG_RX_ADDRESSFOUND) {
     int ret;
 
-    ret = pb_dev_read(&p2G4_dev_state->pb_dev_state,
-                      rx_done_s, sizeof(p2G4_rx_done_t));
+    ret = p2G4_dev_read_i(&p2G4_dev_state->io,
+                          rx_done_s, sizeof(p2G4_rx_done_t));
     if (ret == -1)
       return -1;
 
-    ret = p2G4_rx_pick_packet(&p2G4_dev_state->pb_dev_state,
+    ret = p2G4_rx_pick_packet(&p2G4_dev_state->io,
                               rx_done_s->packet_size, rx_buf, buf_size);
     if (ret)
       return ret;
@@ -231,7 +298,7 @@ int p2G4_dev_req_rx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_t *rx_s,
     } else {
       header = P2G4_MSG_RXSTOP;
     }
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, &header, sizeof(header));
+    p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
 
     if (accept_packet != true) {
       return r_header;
@@ -241,10 +308,10 @@ int p2G4_dev_req_rx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_t *rx_s,
   }
 
   if (r_header == PB_MSG_DISCONNECT) {
-    pb_dev_clean_up(&p2G4_dev_state->pb_dev_state);
+    p2G4_dev_clean_up_i(&p2G4_dev_state->io);
     return -1;
   } else if (r_header == P2G4_MSG_RX_END) {
-    if (pb_dev_read(&p2G4_dev_state->pb_dev_state, rx_done_s, sizeof(p2G4_rx_done_t)) == -1) {
+    if (p2G4_dev_read_i(&p2G4_dev_state->io, rx_done_s, sizeof(p2G4_rx_done_t)) == -1) {
       return -1;
     }
   } else {
@@ -262,6 +329,8 @@ int p2G4_dev_req_rx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_t *rx_s,
  * This buffer shall have buf_size bytes.
  * If buf_size is 0, this function will allocate a new buffer and point
  *  *rx_buf to it (the application must free it afterwards).
+ * If buf_size is P2G4_RXBUF_FROM_POOL, the buffer will be taken from this
+ * connection pool, and shall be given back with p2G4_dev_rx_pool_release_s_c().
  * Otherwise this function will fail if the buffer is too small to fit
  * the incoming packet
  *
@@ -279,24 +348,23 @@ int p2G4_dev_req_rxv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rxv2_t *rx_
 
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
 
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp,
-              P2G4_MSG_RXV2, (void *)rx_s, sizeof(p2G4_rxv2_t));
-  if (rx_s->n_addr > 0) {
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, phy_addr, sizeof(p2G4_address_t)*rx_s->n_addr);
-  }
+  p2G4_dev_req_rxv2_i(&p2G4_dev_state->io, rx_s, phy_addr);
 
   pc_header_t r_header;
+  bool got_address = false;
   r_header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &rx_s->abort);
 
   if (r_header == P2G4_MSG_RXV2_ADDRESSFOUND) {
     int ret;
 
-    ret = pb_dev_read(&p2G4_dev_state->pb_dev_state,
-                      rx_done_s, sizeof(p2G4_rxv2_done_t));
+    got_address = true;
+
+    ret = p2G4_dev_read_i(&p2G4_dev_state->io,
+                          rx_done_s, sizeof(p2G4_rxv2_done_t));
     if (ret == -1)
       return -1;
 
-    ret = p2G4_rx_pick_packet(&p2G4_dev_state->pb_dev_state,
+    ret = p2G4_rx_pick_packet(&p2G4_dev_state->io,
                               rx_done_s->packet_size, rx_buf, buf_size);
     if (ret)
       return ret;
@@ -311,7 +379,7 @@ int p2G4_dev_req_rxv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rxv2_t *rx_
     } else {
       header = P2G4_MSG_RXSTOP;
     }
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, &header, sizeof(header));
+    p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
 
     if (accept_packet != true) {
       return r_header;
@@ -321,10 +389,11 @@ int p2G4_dev_req_rxv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rxv2_t *rx_
   }
 
   if (r_header == PB_MSG_DISCONNECT) {
-    pb_dev_clean_up(&p2G4_dev_state->pb_dev_state);
+    p2G4_dev_clean_up_i(&p2G4_dev_state->io);
     return -1;
   } else if (r_header == P2G4_MSG_RXV2_END) {
-    if (pb_dev_read(&p2G4_dev_state->pb_dev_state, rx_done_s, sizeof(p2G4_rxv2_done_t)) == -1) {
+    if (p2G4_dev_read_rxv2_end_i(&p2G4_dev_state->io, rx_done_s, got_address,
+                                 rx_buf, buf_size) == -1) {
       return -1;
     }
   } else {
@@ -342,6 +411,8 @@ int p2G4_dev_req_rxv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rxv2_t *rx_
  * This buffer shall have buf_size bytes.
  * If buf_size is 0, this function will allocate a new buffer and point
  *  *rx_buf to it (the application must free it afterwards).
+ * If buf_size is P2G4_RXBUF_FROM_POOL, the buffer will be taken from this
+ * connection pool, and shall be given back with p2G4_dev_rx_pool_release_s_c().
  * Otherwise this function will fail if the buffer is too small to fit
  * the incoming packet
  *
@@ -359,24 +430,23 @@ int p2G4_dev_req_rx2v1_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx2v1_t *r
 
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
 
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp,
-              P2G4_MSG_RX2V1, (void *)rx_s, sizeof(p2G4_rx2v1_t));
-  if (rx_s->n_addr > 0) {
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, phy_addr, sizeof(p2G4_address_t)*rx_s->n_addr);
-  }
+  p2G4_dev_req_rx2v1_i(&p2G4_dev_state->io, rx_s, phy_addr);
 
   pc_header_t r_header;
+  bool got_address = false;
   r_header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &rx_s->abort);
 
   if (r_header == P2G4_MSG_RXV2_ADDRESSFOUND) {
     int ret;
 
-    ret = pb_dev_read(&p2G4_dev_state->pb_dev_state,
-                      rx_done_s, sizeof(p2G4_rxv2_done_t));
+    got_address = true;
+
+    ret = p2G4_dev_read_i(&p2G4_dev_state->io,
+                          rx_done_s, sizeof(p2G4_rxv2_done_t));
     if (ret == -1)
       return -1;
 
-    ret = p2G4_rx_pick_packet(&p2G4_dev_state->pb_dev_state,
+    ret = p2G4_rx_pick_packet(&p2G4_dev_state->io,
                               rx_done_s->packet_size, rx_buf, buf_size);
     if (ret)
       return ret;
@@ -391,7 +461,7 @@ int p2G4_dev_req_rx2v1_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx2v1_t *r
     } else {
       header = P2G4_MSG_RXSTOP;
     }
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, &header, sizeof(header));
+    p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
 
     if (accept_packet != true) {
       return r_header;
@@ -401,10 +471,222 @@ int p2G4_dev_req_rx2v1_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx2v1_t *r
   }
 
   if (r_header == PB_MSG_DISCONNECT) {
-    pb_dev_clean_up(&p2G4_dev_state->pb_dev_state);
+    p2G4_dev_clean_up_i(&p2G4_dev_state->io);
     return -1;
   } else if (r_header == P2G4_MSG_RXV2_END) {
-    if (pb_dev_read(&p2G4_dev_state->pb_dev_state, rx_done_s, sizeof(p2G4_rxv2_done_t)) == -1) {
+    if (p2G4_dev_read_rxv2_end_i(&p2G4_dev_state->io, rx_done_s, got_address,
+                                 rx_buf, buf_size) == -1) {
+      return -1;
+    }
+  } else {
+    INVALID_RESP(r_header);
+  }
+  return r_header;
+}
+
+/**
+ * Request a streaming reception to the phy, and block until the stream ends
+ *
+ * For every packet received (and, if rx_s->report_nosync, for every scan
+ * window which ended without sync), rx_done_s is updated, the packet is
+ * placed in *rx_buf (as for p2G4_dev_req_rxv2_s_c_b()), and packet_f() is
+ * called.
+ * Note that with buf_size == 0 each packet gets a new buffer, which
+ * the device must free. Using P2G4_RXBUF_FROM_POOL is recommended instead.
+ * packet_f() shall return 0 to continue receiving, or != 0 to end the
+ * stream right away (at that packet end_time).
+ *
+ * If rx_s->auto_accept is 0, dev_rxeval_f (if not NULL) is called for each
+ * packet when its address and header are received, as for
+ * p2G4_dev_req_rxv2_s_c_b(). If it rejects the packet, the stream continues.
+ *
+ * returns -1 on error, P2G4_MSG_RX_STREAM_END otherwise
+ */
+int p2G4_dev_req_rx_stream_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_stream_t *rx_s,
+                                 p2G4_address_t *phy_addr, p2G4_freq2_t *channels,
+                                 p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf,
+                                 size_t buf_size, device_eval_rxv2_f dev_rxeval_f,
+                                 device_rx_stream_packet_f packet_f) {
+  bool got_address = false;
+  pc_header_t r_header;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  p2G4_dev_req_rx_stream_i(&p2G4_dev_state->io, rx_s, phy_addr, channels);
+
+  while (1) {
+    r_header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &rx_s->rx.abort);
+    if (r_header == (pc_header_t)-1) {
+      return -1;
+    }
+
+    if ((r_header == P2G4_MSG_RXV2_ADDRESSFOUND) && (got_address == false)) {
+      if (p2G4_dev_read_i(&p2G4_dev_state->io, rx_done_s, sizeof(p2G4_rxv2_done_t)) == -1) {
+        return -1;
+      }
+      if (p2G4_rx_pick_packet(&p2G4_dev_state->io,
+                              rx_done_s->packet_size, rx_buf, buf_size) == -1) {
+        return -1;
+      }
+
+      int accept_packet = true;
+      if (dev_rxeval_f != NULL) {
+        accept_packet = dev_rxeval_f(rx_done_s, *rx_buf);
+      }
+      pc_header_t header;
+      if (accept_packet == true) {
+        header = P2G4_MSG_RXCONT;
+        got_address = true;
+      } else {
+        header = P2G4_MSG_RX_STREAM_SKIP;
+      }
+      p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
+
+    } else if (r_header == P2G4_MSG_RX_STREAM_PACKET) {
+      pc_header_t header = P2G4_MSG_RX_STREAM_CONT;
+
+      if (p2G4_dev_read_i(&p2G4_dev_state->io, rx_done_s, sizeof(p2G4_rxv2_done_t)) == -1) {
+        return -1;
+      }
+      if (got_address == false) {
+        if (p2G4_rx_pick_packet(&p2G4_dev_state->io,
+                                rx_done_s->packet_size, rx_buf, buf_size) == -1) {
+          return -1;
+        }
+      }
+      got_address = false;
+
+      if ((packet_f != NULL) && (packet_f(rx_done_s, *rx_buf) != 0)) {
+        /* The phy will acknowledge it with the P2G4_MSG_RX_STREAM_END */
+        header = P2G4_MSG_RX_STREAM_STOP;
+      }
+      p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
+
+    } else if (r_header == P2G4_MSG_RX_STREAM_END) {
+      if (p2G4_dev_read_i(&p2G4_dev_state->io, rx_done_s, sizeof(p2G4_rxv2_done_t)) == -1) {
+        return -1;
+      }
+      return r_header;
+
+    } else if (r_header == PB_MSG_DISCONNECT) {
+      p2G4_dev_clean_up_i(&p2G4_dev_state->io);
+      return -1;
+    } else {
+      INVALID_RESP(r_header);
+      return -1;
+    }
+  }
+}
+
+/**
+ * Request a chained reception to the phy: a v2.1 reception followed by
+ * the prelocked reception of each of the next segments of the same packet
+ * (for ex. the FEC2 part of a Coded Phy packet), as one transaction
+ * (see p2G4_rx_chain_t)
+ *
+ * The payload of all segments is placed, one after the other, in one buffer
+ * (rx_buf and buf_size are as for p2G4_dev_req_rx2v1_s_c_b())
+ * done_s is filled with the overall result and the status of each segment
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_req_rx_chain_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_chain_t *chain,
+                                p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr,
+                                p2G4_rx_chain_seg_t *segs, p2G4_rx_chain_done_t *done_s,
+                                uint8_t **rx_buf, size_t buf_size) {
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  pc_header_t header;
+
+  p2G4_dev_req_rx_chain_i(&p2G4_dev_state->io, chain, rx_s, phy_addr, segs);
+
+  header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &rx_s->abort);
+
+  return p2G4_dev_handle_rx_chain_resp_i(&p2G4_dev_state->io, header, done_s,
+                                         rx_buf, buf_size);
+}
+
+/**
+ * Request a reception with several receivers at the same time (see p2G4_rx_multi_t)
+ * and block until all of them have ended
+ *
+ * done_s and rx_bufs need to be arrays of multi_s->n_rx elements, allocated by
+ * the caller. Each receiver result and packet are placed in its element
+ * (each rx_bufs[i] and buf_size are as for p2G4_dev_req_rx2v1_s_c_b())
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_req_rx_multi_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_multi_t *multi_s,
+                                p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr,
+                                p2G4_rxv2_done_t *done_s, uint8_t **rx_bufs, size_t buf_size) {
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  p2G4_rx_multi_tag_t tag;
+  pc_header_t header;
+
+  p2G4_dev_req_rx_multi_i(&p2G4_dev_state->io, multi_s, rxs, phy_addr);
+
+  do {
+    header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &multi_s->abort);
+
+    if (p2G4_dev_handle_rx_multi_resp_i(&p2G4_dev_state->io, header, &tag, done_s,
+                                        multi_s->n_rx, rx_bufs, buf_size) == -1) {
+      return -1;
+    }
+  } while (tag.n_left > 0);
+
+  return 0;
+}
+
+/**
+ * Handle the phy responses to a P2G4_MSG_TXRX or P2G4_MSG_RX_AUTORESP
+ * (both end with a P2G4_MSG_TXRX_END)
+ */
+static int get_txrx_resp_s(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_abort_t *abort,
+                           p2G4_txrx_done_t *done_s, uint8_t **rx_buf,
+                           size_t buf_size, device_eval_rxv2_f dev_rxeval_f) {
+  pc_header_t r_header;
+  bool got_address = false;
+  r_header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, abort);
+
+  if (r_header == P2G4_MSG_RXV2_ADDRESSFOUND) {
+    int ret;
+
+    got_address = true;
+
+    ret = p2G4_dev_read_i(&p2G4_dev_state->io,
+                          &done_s->rx, sizeof(p2G4_rxv2_done_t));
+    if (ret == -1)
+      return -1;
+
+    ret = p2G4_rx_pick_packet(&p2G4_dev_state->io,
+                              done_s->rx.packet_size, rx_buf, buf_size);
+    if (ret)
+      return ret;
+
+    int accept_packet = true;
+    if (dev_rxeval_f != NULL) {
+      accept_packet = dev_rxeval_f(&done_s->rx, *rx_buf);
+    }
+    pc_header_t header;
+    if (accept_packet == true) {
+      header = P2G4_MSG_RXCONT;
+    } else {
+      header = P2G4_MSG_RXSTOP;
+    }
+    p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
+
+    if (accept_packet != true) {
+      return r_header;
+    }
+
+    r_header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, abort);
+  }
+
+  if (r_header == PB_MSG_DISCONNECT) {
+    p2G4_dev_clean_up_i(&p2G4_dev_state->io);
+    return -1;
+  } else if (r_header == P2G4_MSG_TXRX_END) {
+    if (p2G4_dev_read_txrx_end_i(&p2G4_dev_state->io, done_s, got_address,
+                                 rx_buf, buf_size) == -1) {
       return -1;
     }
   } else {
@@ -413,6 +695,55 @@ int p2G4_dev_req_rx2v1_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx2v1_t *r
   return r_header;
 }
 
+/**
+ * Request a transmission followed by a reception to the phy, as one transaction
+ * (see p2G4_txrx_t)
+ *
+ * packet is the Tx payload, and rx_buf, buf_size and dev_rxeval_f are as for
+ * p2G4_dev_req_rx2v1_s_c_b()
+ * done_s is filled with the result of both the Tx and the Rx
+ *
+ * returns -1 on error, the received response header >=0 otherwise
+ */
+int p2G4_dev_req_txrx_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_txrx_t *txrx_s,
+                            p2G4_address_t *phy_addr, uint8_t *packet,
+                            p2G4_txrx_done_t *done_s, uint8_t **rx_buf,
+                            size_t buf_size, device_eval_rxv2_f dev_rxeval_f) {
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  p2G4_dev_req_txrx_i(&p2G4_dev_state->io, txrx_s, phy_addr, packet);
+  p2G4_dev_txrx_tx_done_i(txrx_s, done_s);
+
+  return get_txrx_resp_s(p2G4_dev_state, &txrx_s->abort, done_s,
+                         rx_buf, buf_size, dev_rxeval_f);
+}
+
+/**
+ * Request a reception, followed by an automatic response transmission if the
+ * received packet meets the condition, to the phy, as one transaction
+ * (see p2G4_rx_autoresp_t)
+ *
+ * rules are the n_rules condition rules, packet the response payload,
+ * and rx_buf, buf_size and dev_rxeval_f are as for p2G4_dev_req_rx2v1_s_c_b()
+ * done_s is filled with the result of both the Rx and the Tx
+ *
+ * returns -1 on error, the received response header >=0 otherwise
+ */
+int p2G4_dev_req_rx_autoresp_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_autoresp_t *ar_s,
+                                   p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules,
+                                   uint8_t *packet, p2G4_txrx_done_t *done_s, uint8_t **rx_buf,
+                                   size_t buf_size, device_eval_rxv2_f dev_rxeval_f) {
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  p2G4_dev_req_rx_autoresp_i(&p2G4_dev_state->io, ar_s, phy_addr, rules, packet);
+  p2G4_dev_rx_autoresp_tx_done_i(done_s);
+
+  return get_txrx_resp_s(p2G4_dev_state, &ar_s->abort, done_s,
+                         rx_buf, buf_size, dev_rxeval_f);
+}
+
 /**
  * Request a RSSI measurement to the phy
  * RSSI_done_s needs to be allocated by the caller
@@ -423,9 +754,9 @@ int p2G4_dev_req_RSSI_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state,
                             p2G4_rssi_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s)
 {
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp,
-              P2G4_MSG_RSSIMEAS, (void *)RSSI_s, sizeof(p2G4_rssi_t));
-  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_state->pb_dev_state, RSSI_done_s);
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io,
+                      P2G4_MSG_RSSIMEAS, (void *)RSSI_s, sizeof(p2G4_rssi_t));
+  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_state->io, RSSI_done_s);
 }
 
 /**
@@ -438,9 +769,24 @@ int p2G4_dev_req_RSSIv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state,
                               p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s)
 {
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp,
-              P2G4_MSG_RSSIV2MEAS, (void *)RSSI_s, sizeof(p2G4_rssiv2_t));
-  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_state->pb_dev_state, RSSI_done_s);
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io,
+                      P2G4_MSG_RSSIV2MEAS, (void *)RSSI_s, sizeof(p2G4_rssiv2_t));
+  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_state->io, RSSI_done_s);
+}
+
+/**
+ * Request a sweep of RSSI measurements over several frequencies to the phy
+ * (see p2G4_rssi_sweep_t)
+ * rssi needs to be an array of sweep_s->n_points elements, allocated by the caller
+ *
+ * returns -1 if disconnected, 0 otherwise
+ */
+int p2G4_dev_req_rssi_sweep_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rssi_sweep_t *sweep_s,
+                                  p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi)
+{
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  p2G4_dev_req_rssi_sweep_i(&p2G4_dev_state->io, sweep_s, freqs);
+  return p2G4_dev_get_rssi_sweep_resp_i(&p2G4_dev_state->io, rssi, sweep_s->n_points);
 }
 
 /**
@@ -452,12 +798,12 @@ int p2G4_dev_req_RSSIv2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state,
 int p2G4_dev_req_cca_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_cca_t *cca_s, p2G4_cca_done_t *cca_done_s)
 {
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp, P2G4_MSG_CCA_MEAS, (void *)cca_s, sizeof(p2G4_cca_t));
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_CCA_MEAS, (void *)cca_s, sizeof(p2G4_cca_t));
 
   pc_header_t r_header;
   r_header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &cca_s->abort);
 
-  return p2G4_dev_handle_cca_resp_i(&p2G4_dev_state->pb_dev_state, r_header, cca_done_s);
+  return p2G4_dev_handle_cca_resp_i(&p2G4_dev_state->io, r_header, cca_done_s);
 }
 
 /**
@@ -469,12 +815,31 @@ int p2G4_dev_req_cca_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_cca_t *cca_s
 int p2G4_dev_req_ccav2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_ccav2_t *cca_s, p2G4_cca_done_t *cca_done_s)
 {
   CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp, P2G4_MSG_CCAV2_MEAS, (void *)cca_s, sizeof(p2G4_ccav2_t));
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_CCAV2_MEAS, (void *)cca_s, sizeof(p2G4_ccav2_t));
 
   pc_header_t r_header;
   r_header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &cca_s->abort);
 
-  return p2G4_dev_handle_cca_resp_i(&p2G4_dev_state->pb_dev_state, r_header, cca_done_s);
+  return p2G4_dev_handle_cca_resp_i(&p2G4_dev_state->io, r_header, cca_done_s);
+}
+
+/**
+ * Request a CCA over several frequencies to the phy (see p2G4_cca_multi_t)
+ * cca_done_s needs to be an array of cca_s->n_freqs elements, allocated by the caller
+ *
+ * returns -1 if disconnected, 0 otherwise
+ */
+int p2G4_dev_req_cca_multi_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_cca_multi_t *cca_s,
+                                 p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s)
+{
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+  p2G4_dev_req_cca_multi_i(&p2G4_dev_state->io, cca_s, freqs);
+
+  pc_header_t r_header;
+  r_header = get_resp_while_handling_abortreeval_s(p2G4_dev_state, &cca_s->cca.abort);
+
+  return p2G4_dev_handle_cca_multi_resp_i(&p2G4_dev_state->io, r_header, cca_done_s,
+                                          cca_s->n_freqs);
 }
 
 /**
@@ -484,7 +849,7 @@ int p2G4_dev_req_ccav2_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_ccav2_t *c
  * Otherwise, we should disconnect (-1 will be returned)
  */
 int p2G4_dev_req_wait_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, pb_wait_t *wait_s){
-  return pb_dev_request_wait_block(&p2G4_dev_state->pb_dev_state, wait_s);
+  return p2G4_dev_req_wait_b_i(&p2G4_dev_state->io, wait_s);
 }
 
 
@@ -494,7 +859,7 @@ int p2G4_dev_req_wait_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, pb_wait_t *wait_
  * from the phy with p2G4_dev_pick_wait_resp_s_c_b()
  */
 int p2G4_dev_req_wait_s_c(p2G4_dev_state_s_t *p2G4_dev_state, pb_wait_t *wait_s){
-  return pb_dev_request_wait_nonblock(&p2G4_dev_state->pb_dev_state, wait_s);
+  return p2G4_dev_req_wait_i(&p2G4_dev_state->io, wait_s);
 }
 
 /**
@@ -504,5 +869,179 @@ int p2G4_dev_req_wait_s_c(p2G4_dev_state_s_t *p2G4_dev_state, pb_wait_t *wait_s)
  * Otherwise, we should disconnect (-1 will be returned)
  */
 int p2G4_dev_pick_wait_resp_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state){
-  return pb_dev_pick_wait_resp(&p2G4_dev_state->pb_dev_state);
+  return p2G4_dev_pick_wait_resp_i(&p2G4_dev_state->io);
+}
+
+/**
+ * Provide the phy a schedule of abort substructures for the next Tx, Rx or
+ * CCA request, to be used, in order, each time the current recheck_time is
+ * reached, instead of asking the device.
+ * Only once all <n_steps> are used, the phy will request an abort
+ * reevaluation as usual.
+ * It is sent to the phy with the next request, which shall be a Tx, Rx or CCA.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_abort_sched_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_abort_t *steps, uint n_steps){
+  return p2G4_dev_set_abort_sched_i(&p2G4_dev_state->io, steps, n_steps);
+}
+
+/**
+ * Provide the phy a header filter for the next v2/v2.1 Rx request, so it
+ * accepts or rejects packets on its own instead of asking the device.
+ * With filter->ask_device == 0, the device is only informed at the end of the
+ * reception (so its header evaluation callback is not used)
+ * It is sent to the phy with the next request, which shall be a v2/v2.1 Rx.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_rx_filter_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_filter_t *filter,
+                               p2G4_rx_filter_rule_t *rules){
+  return p2G4_dev_set_rx_filter_i(&p2G4_dev_state->io, filter, rules);
+}
+
+/**
+ * Request RSSI samples to be taken during the next v2/v2.1 Rx request
+ * (see p2G4_rssi_series_t). Get them with p2G4_dev_rx_get_rssi_samples_s_c()
+ * once the reception ends.
+ * It is sent to the phy with the next request, which shall be a v2/v2.1 Rx.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_rx_rssi_series_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rssi_series_t *series){
+  return p2G4_dev_set_rx_rssi_series_i(&p2G4_dev_state->io, series);
+}
+
+/**
+ * Register in the phy a set of <n_addr> addresses (which may be more than
+ * P2G4_RXV2_MAX_ADDRESSES) to be used by later Rx requests,
+ * (see p2G4_dev_set_rx_addr_set_s_c())
+ * It blocks until the phy accepts it, after which *handle is set to the set handle
+ *
+ * returns -1 on error or if the phy rejected the set, 0 otherwise
+ */
+int p2G4_dev_addr_set_register_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_address_t *addr,
+                                   uint32_t n_addr, uint32_t *handle){
+  return p2G4_dev_addr_set_register_i(&p2G4_dev_state->io, addr, n_addr, handle);
+}
+
+/**
+ * Release an address set registered with p2G4_dev_addr_set_register_s_c()
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_addr_set_release_s_c(p2G4_dev_state_s_t *p2G4_dev_state, uint32_t handle){
+  return p2G4_dev_addr_set_release_i(&p2G4_dev_state->io, handle);
+}
+
+/**
+ * Make the next v2/v2.1 Rx request also match the addresses in the registered
+ * set <handle> (besides the addresses in the request itself)
+ * It is sent to the phy with the next request, which shall be a v2/v2.1 Rx.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_rx_addr_set_s_c(p2G4_dev_state_s_t *p2G4_dev_state, uint32_t handle){
+  return p2G4_dev_set_rx_addr_set_i(&p2G4_dev_state->io, handle);
+}
+
+/**
+ * Register a base Tx (v2.1) request, to be used as template for later
+ * requests (see p2G4_dev_use_tmpl_s_c())
+ * *handle is set to the template handle
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_tmpl_register_tx2v1_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_tx2v1_t *tx_s,
+                                     uint32_t *handle){
+  return p2G4_dev_tmpl_register_i(&p2G4_dev_state->io, P2G4_MSG_TX2V1, tx_s, NULL, handle);
+}
+
+/**
+ * Register a base Rx (v2.1) request (and its addresses), to be used as
+ * template for later requests (see p2G4_dev_use_tmpl_s_c())
+ * *handle is set to the template handle
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_tmpl_register_rx2v1_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx2v1_t *rx_s,
+                                     p2G4_address_t *phy_addr, uint32_t *handle){
+  return p2G4_dev_tmpl_register_i(&p2G4_dev_state->io, P2G4_MSG_RX2V1, rx_s, phy_addr, handle);
+}
+
+/**
+ * Send the next Tx or Rx (v2.1) request based on the template <handle>:
+ * If the request only differs from the template in its start time, center
+ * frequency and/or abort, only those are sent to the phy. Otherwise the
+ * request is sent in full, as usual.
+ * Shall be called right before the request it applies to.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_use_tmpl_s_c(p2G4_dev_state_s_t *p2G4_dev_state, uint32_t handle){
+  return p2G4_dev_use_tmpl_i(&p2G4_dev_state->io, handle);
+}
+
+/**
+ * Fetch <size> bytes, starting at <offset>, of the payload of the packet
+ * being (from the header evaluation callback) or last received, into buf
+ * (For Rx requests with resp_type P2G4_RESP_PAYLOAD_NONE/HEADER)
+ *
+ * returns -1 on error, the number of bytes copied otherwise (less than
+ * requested if the packet is shorter)
+ */
+int p2G4_dev_rx_fetch_payload_s_c(p2G4_dev_state_s_t *p2G4_dev_state, uint16_t offset,
+                                  uint16_t size, uint8_t *buf){
+  return p2G4_dev_rx_fetch_payload_i(&p2G4_dev_state->io, offset, size, buf);
+}
+
+/**
+ * Get the progress of the packet being received in P2G4_RESP_PAYLOAD_CHUNKED
+ * mode (for ex. during an abort reevaluation callback)
+ * The bytes [0, progress->received) are already in the reception buffer
+ */
+void p2G4_dev_rx_get_progress_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_progress_t *progress){
+  *progress = p2G4_dev_state->io.rx_progress;
+}
+
+/**
+ * From the abort reevaluation or header evaluation callbacks, request from
+ * the phy the bit error mask of the packet being received, from <start_bit>
+ * on (the device already has the runs before it).
+ * It can then be read with p2G4_dev_rx_get_error_mask_s_c()
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_req_imm_error_mask_s_c_b(p2G4_dev_state_s_t *p2G4_dev_state, uint32_t start_bit){
+  return p2G4_dev_imm_req_error_mask_i(&p2G4_dev_state->io, start_bit);
+}
+
+/**
+ * Get the bit error mask of the packet being/last received
+ * (see P2G4_RESP_ERROR_MASK and p2G4_rx_apply_error_mask())
+ */
+void p2G4_dev_rx_get_error_mask_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_error_mask_t *mask){
+  p2G4_dev_rx_get_error_mask_i(&p2G4_dev_state->io, mask);
+}
+
+/**
+ * Get the RSSI samples taken during the last reception
+ * (see p2G4_dev_set_rx_rssi_series_s_c())
+ */
+void p2G4_dev_rx_get_rssi_samples_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_rssi_samples_t *samples){
+  p2G4_dev_rx_get_rssi_samples_i(&p2G4_dev_state->io, samples);
+}
+
+/**
+ * Give back a reception buffer obtained with buf_size = P2G4_RXBUF_FROM_POOL
+ */
+void p2G4_dev_rx_pool_release_s_c(p2G4_dev_state_s_t *p2G4_dev_state, uint8_t *buf){
+  p2G4_rx_pool_release(&p2G4_dev_state->io.rx_pool, buf);
+}
+
+/**
+ * Get the reception buffer pool statistics (hits/misses)
+ */
+void p2G4_dev_rx_pool_get_stats_s_c(p2G4_dev_state_s_t *p2G4_dev_state, p2G4_rx_pool_stats_t *stats){
+  p2G4_rx_pool_get_stats(&p2G4_dev_state->io.rx_pool, stats);
 }
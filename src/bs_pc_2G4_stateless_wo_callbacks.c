@@ -10,22 +10,26 @@
 
 int p2G4_dev_initCom_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, uint d,
                           const char* s, const char* p) {
-  return pb_dev_init_com(&p2G4_dev_state->pb_dev_state, d, s, p);
+  p2G4_dev_state->rx_stream = false;
+  p2G4_dev_state->rx_multi = false;
+  p2G4_dev_state->rx_chain_done_s = NULL;
+  p2G4_dev_state->txrx_done_s = NULL;
+  return p2G4_dev_init_com_i(&p2G4_dev_state->io, &p2G4_dev_state->pb_dev_state, d, s, p);
 }
 
 void p2G4_dev_terminate_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state){
-  pb_dev_terminate(&p2G4_dev_state->pb_dev_state);
+  p2G4_dev_terminate_i(&p2G4_dev_state->io);
 }
 
 void p2G4_dev_disconnect_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state){
-  pb_dev_disconnect(&p2G4_dev_state->pb_dev_state);
+  p2G4_dev_disconnect_i(&p2G4_dev_state->io);
 }
 
 static int p2G4_dev_get_tx_resp_nc(p2G4_dev_state_nc_t *c2G4_dev_st) {
   pc_header_t header;
   int ret;
 
-  ret = pb_dev_read(&c2G4_dev_st->pb_dev_state, &header, sizeof(pc_header_t));
+  ret = p2G4_dev_read_header_i(&c2G4_dev_st->io, &header);
   if (ret == -1)
     return -1;
 
@@ -36,7 +40,13 @@ static int p2G4_dev_get_tx_resp_nc(p2G4_dev_state_nc_t *c2G4_dev_st) {
 
   c2G4_dev_st->ongoing = Nothing_2G4;
 
-  ret = p2G4_dev_handle_tx_resp_i(&c2G4_dev_st->pb_dev_state, header, c2G4_dev_st->tx_done_s);
+  if (c2G4_dev_st->tx_chain_done_s != NULL) {
+    ret = p2G4_dev_handle_tx_chain_resp_i(&c2G4_dev_st->io, header, c2G4_dev_st->tx_chain_done_s);
+  } else if (c2G4_dev_st->cca_tx_done_s != NULL) {
+    ret = p2G4_dev_handle_cca_tx_resp_i(&c2G4_dev_st->io, header, c2G4_dev_st->cca_tx_done_s);
+  } else {
+    ret = p2G4_dev_handle_tx_resp_i(&c2G4_dev_st->io, header, c2G4_dev_st->tx_done_s);
+  }
   if (ret == -1)
     return -1;
   else
@@ -47,7 +57,7 @@ static int p2G4_dev_get_cca_resp_nc(p2G4_dev_state_nc_t *c2G4_dev_st) {
   pc_header_t header;
   int ret;
 
-  ret = pb_dev_read(&c2G4_dev_st->pb_dev_state, &header, sizeof(pc_header_t));
+  ret = p2G4_dev_read_header_i(&c2G4_dev_st->io, &header);
   if (ret == -1)
     return -1;
 
@@ -58,7 +68,12 @@ static int p2G4_dev_get_cca_resp_nc(p2G4_dev_state_nc_t *c2G4_dev_st) {
 
   c2G4_dev_st->ongoing = Nothing_2G4;
 
-  ret = p2G4_dev_handle_cca_resp_i(&c2G4_dev_st->pb_dev_state, header, c2G4_dev_st->cca_done_s);
+  if (c2G4_dev_st->cca_n_freqs > 0) {
+    ret = p2G4_dev_handle_cca_multi_resp_i(&c2G4_dev_st->io, header, c2G4_dev_st->cca_done_s,
+                                           c2G4_dev_st->cca_n_freqs);
+  } else {
+    ret = p2G4_dev_handle_cca_resp_i(&c2G4_dev_st->io, header, c2G4_dev_st->cca_done_s);
+  }
   if (ret == -1)
     return -1;
   else
@@ -81,12 +96,14 @@ int p2G4_dev_req_tx_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_tx_t *tx_s, ui
 
   CHECK_CONNECTED(c2G4_dev_st->pb_dev_state.connected);
   c2G4_dev_st->tx_done_s = tx_done_s;
+  c2G4_dev_st->tx_chain_done_s = NULL;
+  c2G4_dev_st->cca_tx_done_s = NULL;
 
   if ( c2G4_dev_st->ongoing != Nothing_2G4 ) {
     bs_trace_error_time_line("Tried to request a new tx while some other transaction was ongoing\n");
   }
 
-  p2G4_dev_req_tx_i(&c2G4_dev_st->pb_dev_state, tx_s, packet);
+  p2G4_dev_req_tx_i(&c2G4_dev_st->io, tx_s, packet);
 
   return p2G4_dev_get_tx_resp_nc(c2G4_dev_st);
 }
@@ -107,12 +124,14 @@ int p2G4_dev_req_txv2_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_txv2_t *tx_s
 
   CHECK_CONNECTED(c2G4_dev_st->pb_dev_state.connected);
   c2G4_dev_st->tx_done_s = tx_done_s;
+  c2G4_dev_st->tx_chain_done_s = NULL;
+  c2G4_dev_st->cca_tx_done_s = NULL;
 
   if ( c2G4_dev_st->ongoing != Nothing_2G4 ) {
     bs_trace_error_time_line("Tried to request a new tx while some other transaction was ongoing\n");
   }
 
-  p2G4_dev_req_txv2_i(&c2G4_dev_st->pb_dev_state, tx_s, packet);
+  p2G4_dev_req_txv2_i(&c2G4_dev_st->io, tx_s, packet);
 
   return p2G4_dev_get_tx_resp_nc(c2G4_dev_st);
 }
@@ -133,12 +152,105 @@ int p2G4_dev_req_tx2v1_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_tx2v1_t *tx
 
   CHECK_CONNECTED(c2G4_dev_st->pb_dev_state.connected);
   c2G4_dev_st->tx_done_s = tx_done_s;
+  c2G4_dev_st->tx_chain_done_s = NULL;
+  c2G4_dev_st->cca_tx_done_s = NULL;
+
+  if ( c2G4_dev_st->ongoing != Nothing_2G4 ) {
+    bs_trace_error_time_line("Tried to request a new tx while some other transaction was ongoing\n");
+  }
+
+  p2G4_dev_req_tx2v1_i(&c2G4_dev_st->io, tx_s, packet);
+
+  return p2G4_dev_get_tx_resp_nc(c2G4_dev_st);
+}
+
+/**
+ * Request a transmission (v2.1) to the phy without waiting for its response
+ * ("posted" Tx)
+ *
+ * If the transmission cannot be aborted (abort_time and recheck_time are
+ * TIME_NEVER), its outcome is known in advance: tx_done_s is filled right
+ * away, and the phy will not send a response.
+ * Otherwise this behaves just like p2G4_dev_req_tx2v1_s_nc_b()
+ *
+ * returns -1 on error, otherwise the response from the phy
+ * (P2G4_MSG_TX_END for posted transmissions)
+ */
+int p2G4_dev_req_tx2v1_posted_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_tx2v1_t *tx_s, uint8_t *packet, p2G4_tx_done_t *tx_done_s) {
+
+  if (!p2G4_dev_tx2v1_postable_i(tx_s)) {
+    return p2G4_dev_req_tx2v1_s_nc_b(c2G4_dev_st, tx_s, packet, tx_done_s);
+  }
+
+  CHECK_CONNECTED(c2G4_dev_st->pb_dev_state.connected);
+
+  if ( c2G4_dev_st->ongoing != Nothing_2G4 ) {
+    bs_trace_error_time_line("Tried to request a new tx while some other transaction was ongoing\n");
+  }
+
+  p2G4_dev_req_tx2v1_posted_i(&c2G4_dev_st->io, tx_s, packet, tx_done_s);
+  return P2G4_MSG_TX_END;
+}
+
+/**
+ * Request a chained transmission to the phy: n_segs back to back
+ * segments (for ex. the FEC1 and FEC2 parts of a Coded Phy packet),
+ * handled as one transaction (see p2G4_tx_chain_t)
+ *
+ * packet contains all segments payloads, one after the other
+ * done_s needs to point to an allocated structure, which will be filled with
+ * the status of each segment
+ *
+ * returns -1 on error, otherwise the response from the phy.
+ * Possible phy responses are:
+ *   * P2G4_MSG_TX_CHAIN_END : (updates done_s)
+ *        The transaction has terminated, the device may start a new transaction
+ *   * P2G4_MSG_ABORTREEVAL
+ *        The device shall call p2G4_dev_provide_new_tx_abort_s_nc_b() with a new abort structure
+ */
+int p2G4_dev_req_tx_chain_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_tx_chain_t *chain,
+                                 p2G4_tx2v1_t *segs, uint8_t *packet, p2G4_tx_chain_done_t *done_s) {
+
+  CHECK_CONNECTED(c2G4_dev_st->pb_dev_state.connected);
+  c2G4_dev_st->tx_done_s = NULL;
+  c2G4_dev_st->tx_chain_done_s = done_s;
+  c2G4_dev_st->cca_tx_done_s = NULL;
+
+  if ( c2G4_dev_st->ongoing != Nothing_2G4 ) {
+    bs_trace_error_time_line("Tried to request a new tx while some other transaction was ongoing\n");
+  }
+
+  p2G4_dev_req_tx_chain_i(&c2G4_dev_st->io, chain, segs, packet);
+
+  return p2G4_dev_get_tx_resp_nc(c2G4_dev_st);
+}
+
+/**
+ * Request a CCA followed by a transmission, only if the channel is found clear,
+ * to the phy, as one transaction (see p2G4_cca_tx_t)
+ *
+ * backoffs are the n_backoffs CCA retry backoffs, and packet the Tx payload
+ * done_s needs to point to an allocated structure. Its content will be overwritten
+ *
+ * returns -1 on error, otherwise the response from the phy.
+ * The phy response may be:
+ *   * P2G4_MSG_CCA_TX_END : (updates done_s)
+ *   * P2G4_MSG_ABORTREEVAL
+ *        The device shall call p2G4_dev_provide_new_tx_abort_s_nc_b() with a new abort structure
+ */
+int p2G4_dev_req_cca_tx_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_cca_tx_t *cca_tx_s,
+                               uint32_t *backoffs, uint8_t *packet, p2G4_cca_tx_done_t *done_s) {
+
+  CHECK_CONNECTED(c2G4_dev_st->pb_dev_state.connected);
+  c2G4_dev_st->tx_done_s = NULL;
+  c2G4_dev_st->tx_chain_done_s = NULL;
+  c2G4_dev_st->cca_tx_done_s = done_s;
 
   if ( c2G4_dev_st->ongoing != Nothing_2G4 ) {
     bs_trace_error_time_line("Tried to request a new tx while some other transaction was ongoing\n");
   }
 
-  p2G4_dev_req_tx2v1_i(&c2G4_dev_st->pb_dev_state, tx_s, packet);
+  p2G4_dev_req_cca_tx_i(&c2G4_dev_st->io, cca_tx_s, backoffs, packet);
 
   return p2G4_dev_get_tx_resp_nc(c2G4_dev_st);
 }
@@ -159,8 +271,8 @@ int p2G4_dev_provide_new_tx_abort_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_
     bs_trace_error_time_line("Tried to send a new Tx Abort substruct but we are not in a Tx transaction abort reevaluation!\n");
   }
 
-  pb_send_msg(c2G4_dev_st->pb_dev_state.ff_dtp, P2G4_MSG_RERESP_ABORTREEVAL,
-              (void *)abort, sizeof(p2G4_abort_t));
+  p2G4_dev_send_msg_i(&c2G4_dev_st->io, P2G4_MSG_RERESP_ABORTREEVAL,
+                      (void *)abort, sizeof(p2G4_abort_t));
 
   return p2G4_dev_get_tx_resp_nc(c2G4_dev_st);
 }
@@ -182,13 +294,14 @@ int p2G4_dev_req_cca_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_cca_t *cca_s,
 
   CHECK_CONNECTED(c2G4_dev_st->pb_dev_state.connected);
   c2G4_dev_st->cca_done_s = cca_done_s;
+  c2G4_dev_st->cca_n_freqs = 0;
 
   if ( c2G4_dev_st->ongoing != Nothing_2G4 ) {
     bs_trace_error_time_line("Tried to request a new CCA while some other transaction was ongoing\n");
   }
 
-  pb_send_msg(c2G4_dev_st->pb_dev_state.ff_dtp, P2G4_MSG_CCA_MEAS,
-              (void *)cca_s, sizeof(p2G4_cca_t));
+  p2G4_dev_send_msg_i(&c2G4_dev_st->io, P2G4_MSG_CCA_MEAS,
+                      (void *)cca_s, sizeof(p2G4_cca_t));
 
   return p2G4_dev_get_cca_resp_nc(c2G4_dev_st);
 }
@@ -209,13 +322,42 @@ int p2G4_dev_req_ccav2_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_ccav2_t *cc
 
   CHECK_CONNECTED(c2G4_dev_st->pb_dev_state.connected);
   c2G4_dev_st->cca_done_s = cca_done_s;
+  c2G4_dev_st->cca_n_freqs = 0;
+
+  if ( c2G4_dev_st->ongoing != Nothing_2G4 ) {
+    bs_trace_error_time_line("Tried to request a new CCA while some other transaction was ongoing\n");
+  }
+
+  p2G4_dev_send_msg_i(&c2G4_dev_st->io, P2G4_MSG_CCAV2_MEAS,
+                      (void *)cca_s, sizeof(p2G4_ccav2_t));
+
+  return p2G4_dev_get_cca_resp_nc(c2G4_dev_st);
+}
+
+/**
+ * Request a CCA over several frequencies to the phy (see p2G4_cca_multi_t)
+ *
+ * cca_done_s needs to point to an allocated array of cca_s->n_freqs elements.
+ * Its content will be overwritten
+ *
+ * returns -1 on error, otherwise the response from the phy.
+ * The phy response may be:
+ *   * P2G4_MSG_CCA_MULTI_END : (updates the cca_done_s)
+ *   * P2G4_MSG_ABORTREEVAL
+ *        The device shall call p2G4_dev_provide_new_cca_abort_s_nc_b() with a new abort structure
+ */
+int p2G4_dev_req_cca_multi_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4_cca_multi_t *cca_s,
+                                  p2G4_freq2_t *freqs, p2G4_cca_done_t *cca_done_s) {
+
+  CHECK_CONNECTED(c2G4_dev_st->pb_dev_state.connected);
+  c2G4_dev_st->cca_done_s = cca_done_s;
+  c2G4_dev_st->cca_n_freqs = cca_s->n_freqs;
 
   if ( c2G4_dev_st->ongoing != Nothing_2G4 ) {
     bs_trace_error_time_line("Tried to request a new CCA while some other transaction was ongoing\n");
   }
 
-  pb_send_msg(c2G4_dev_st->pb_dev_state.ff_dtp, P2G4_MSG_CCAV2_MEAS,
-              (void *)cca_s, sizeof(p2G4_ccav2_t));
+  p2G4_dev_req_cca_multi_i(&c2G4_dev_st->io, cca_s, freqs);
 
   return p2G4_dev_get_cca_resp_nc(c2G4_dev_st);
 }
@@ -236,8 +378,8 @@ int p2G4_dev_provide_new_cca_abort_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4
     bs_trace_error_time_line("Tried to send a new CCA Abort substruct but we are not in a CCA transaction abort reevaluation!\n");
   }
 
-  pb_send_msg(c2G4_dev_st->pb_dev_state.ff_dtp, P2G4_MSG_RERESP_ABORTREEVAL,
-              (void *)abort, sizeof(p2G4_abort_t));
+  p2G4_dev_send_msg_i(&c2G4_dev_st->io, P2G4_MSG_RERESP_ABORTREEVAL,
+                      (void *)abort, sizeof(p2G4_abort_t));
 
   return p2G4_dev_get_cca_resp_nc(c2G4_dev_st);
 }
@@ -249,7 +391,7 @@ int p2G4_dev_provide_new_cca_abort_s_nc_b(p2G4_dev_state_nc_t *c2G4_dev_st, p2G4
  * Otherwise, we should disconnect (-1 will be returned)
  */
 int p2G4_dev_req_wait_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, pb_wait_t *wait_s){
-  return pb_dev_request_wait_block(&p2G4_dev_state->pb_dev_state, wait_s);
+  return p2G4_dev_req_wait_b_i(&p2G4_dev_state->io, wait_s);
 }
 
 static int c2G4_handle_rx_responses_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, pc_header_t header){
@@ -260,11 +402,11 @@ static int c2G4_handle_rx_responses_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, pc_he
     c2G4_dev_st->ongoing = Rx_Abort_Reeval_2G4;
 
   } else if ((header == P2G4_MSG_RX_ADDRESSFOUND) && (c2G4_dev_st->WeGotAddress == false )) {
-    ret = pb_dev_read(&c2G4_dev_st->pb_dev_state, rx_done_s, sizeof(p2G4_rx_done_t));
+    ret = p2G4_dev_read_i(&c2G4_dev_st->io, rx_done_s, sizeof(p2G4_rx_done_t));
     if (ret == -1)
       return -1;
 
-    ret = p2G4_rx_pick_packet(&c2G4_dev_st->pb_dev_state, rx_done_s->packet_size,
+    ret = p2G4_rx_pick_packet(&c2G4_dev_st->io, rx_done_s->packet_size,
                               c2G4_dev_st->rxbuf, c2G4_dev_st->bufsize);
     if (ret == -1)
       return ret;
@@ -274,12 +416,12 @@ static int c2G4_handle_rx_responses_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, pc_he
 
   } else if (header == PB_MSG_DISCONNECT) {
     c2G4_dev_st->ongoing = Nothing_2G4;
-    pb_dev_clean_up(&c2G4_dev_st->pb_dev_state);
+    p2G4_dev_clean_up_i(&c2G4_dev_st->io);
     return -1;
   } else if (header == P2G4_MSG_RX_END) {
     c2G4_dev_st->ongoing = Nothing_2G4;
-    ret = pb_dev_read(&c2G4_dev_st->pb_dev_state, rx_done_s, sizeof(p2G4_rx_done_t));
-    if (ret == 1)
+    ret = p2G4_dev_read_i(&c2G4_dev_st->io, rx_done_s, sizeof(p2G4_rx_done_t));
+    if (ret == -1)
       return -1;
   } else {
     INVALID_RESP(header);
@@ -295,11 +437,11 @@ static int c2G4_handle_rxv2_responses_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, pc_
     c2G4_dev_st->ongoing = Rx_Abort_Reeval_2G4;
 
   } else if ((header == P2G4_MSG_RXV2_ADDRESSFOUND) && (c2G4_dev_st->WeGotAddress == false )) {
-    ret = pb_dev_read(&c2G4_dev_st->pb_dev_state, rx_done_s, sizeof(p2G4_rxv2_done_t));
+    ret = p2G4_dev_read_i(&c2G4_dev_st->io, rx_done_s, sizeof(p2G4_rxv2_done_t));
     if (ret == -1)
       return -1;
 
-    ret = p2G4_rx_pick_packet(&c2G4_dev_st->pb_dev_state, rx_done_s->packet_size,
+    ret = p2G4_rx_pick_packet(&c2G4_dev_st->io, rx_done_s->packet_size,
                               c2G4_dev_st->rxbuf, c2G4_dev_st->bufsize);
     if (ret == -1)
       return ret;
@@ -309,12 +451,80 @@ static int c2G4_handle_rxv2_responses_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, pc_
 
   } else if (header == PB_MSG_DISCONNECT) {
     c2G4_dev_st->ongoing = Nothing_2G4;
-    pb_dev_clean_up(&c2G4_dev_st->pb_dev_state);
+    p2G4_dev_clean_up_i(&c2G4_dev_st->io);
     return -1;
   } else if (header == P2G4_MSG_RXV2_END) {
     c2G4_dev_st->ongoing = Nothing_2G4;
-    ret = pb_dev_read(&c2G4_dev_st->pb_dev_state, rx_done_s, sizeof(p2G4_rxv2_done_t));
-    if (ret == 1)
+    ret = p2G4_dev_read_rxv2_end_i(&c2G4_dev_st->io, rx_done_s, c2G4_dev_st->WeGotAddress,
+                                   c2G4_dev_st->rxbuf, c2G4_dev_st->bufsize);
+    if (ret == -1)
+      return -1;
+  } else if ((header == P2G4_MSG_TXRX_END) && (c2G4_dev_st->txrx_done_s != NULL)) {
+    c2G4_dev_st->ongoing = Nothing_2G4;
+    ret = p2G4_dev_read_txrx_end_i(&c2G4_dev_st->io, c2G4_dev_st->txrx_done_s,
+                                   c2G4_dev_st->WeGotAddress,
+                                   c2G4_dev_st->rxbuf, c2G4_dev_st->bufsize);
+    c2G4_dev_st->txrx_done_s = NULL;
+    if (ret == -1)
+      return -1;
+  } else if ((header == P2G4_MSG_RX_CHAIN_END) && (c2G4_dev_st->rx_chain_done_s != NULL)) {
+    c2G4_dev_st->ongoing = Nothing_2G4;
+    ret = p2G4_dev_handle_rx_chain_resp_i(&c2G4_dev_st->io, header, c2G4_dev_st->rx_chain_done_s,
+                                          c2G4_dev_st->rxbuf, c2G4_dev_st->bufsize);
+    c2G4_dev_st->rx_chain_done_s = NULL;
+    if (ret == -1)
+      return -1;
+  } else {
+    INVALID_RESP(header);
+  }
+  return header;
+}
+
+static int c2G4_handle_rx_stream_responses_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, pc_header_t header){
+  int ret;
+  p2G4_rxv2_done_t *rx_done_s = c2G4_dev_st->rxv2_done_s;
+
+  if (header == P2G4_MSG_ABORTREEVAL) {
+    c2G4_dev_st->ongoing = Rx_Abort_Reeval_2G4;
+
+  } else if ((header == P2G4_MSG_RXV2_ADDRESSFOUND) && (c2G4_dev_st->WeGotAddress == false )) {
+    ret = p2G4_dev_read_i(&c2G4_dev_st->io, rx_done_s, sizeof(p2G4_rxv2_done_t));
+    if (ret == -1)
+      return -1;
+
+    ret = p2G4_rx_pick_packet(&c2G4_dev_st->io, rx_done_s->packet_size,
+                              c2G4_dev_st->rxbuf, c2G4_dev_st->bufsize);
+    if (ret == -1)
+      return ret;
+
+    c2G4_dev_st->WeGotAddress = true;
+    c2G4_dev_st->ongoing = Rx_Header_Eval_2G4;
+
+  } else if (header == P2G4_MSG_RX_STREAM_PACKET) {
+    ret = p2G4_dev_read_i(&c2G4_dev_st->io, rx_done_s, sizeof(p2G4_rxv2_done_t));
+    if (ret == -1)
+      return -1;
+
+    if (c2G4_dev_st->WeGotAddress == false) {
+      ret = p2G4_rx_pick_packet(&c2G4_dev_st->io, rx_done_s->packet_size,
+                                c2G4_dev_st->rxbuf, c2G4_dev_st->bufsize);
+      if (ret == -1)
+        return ret;
+    }
+    c2G4_dev_st->WeGotAddress = false;
+    c2G4_dev_st->rx_stream_packet = true;
+    c2G4_dev_st->ongoing = Rx_Stream_2G4;
+
+  } else if (header == PB_MSG_DISCONNECT) {
+    c2G4_dev_st->ongoing = Nothing_2G4;
+    c2G4_dev_st->rx_stream = false;
+    p2G4_dev_clean_up_i(&c2G4_dev_st->io);
+    return -1;
+  } else if (header == P2G4_MSG_RX_STREAM_END) {
+    c2G4_dev_st->ongoing = Nothing_2G4;
+    c2G4_dev_st->rx_stream = false;
+    ret = p2G4_dev_read_i(&c2G4_dev_st->io, rx_done_s, sizeof(p2G4_rxv2_done_t));
+    if (ret == -1)
       return -1;
   } else {
     INVALID_RESP(header);
@@ -322,6 +532,28 @@ static int c2G4_handle_rxv2_responses_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, pc_
   return header;
 }
 
+static int c2G4_handle_rx_multi_responses_s_nc(p2G4_dev_state_nc_t *c2G4_dev_st, pc_header_t header){
+  if (header == P2G4_MSG_ABORTREEVAL) {
+    c2G4_dev_st->ongoing = Rx_Abort_Reeval_2G4;
+    return header;
+  }
+
+  if (p2G4_dev_handle_rx_multi_resp_i(&c2G4_dev_st->io, header, c2G4_dev_st->rx_multi_tag_s,
+                                      c2G4_dev_st->rxv2_done_s, c2G4_dev_st->rx_multi_n,
+                                      c2G4_dev_st->rxbuf, c2G4_dev_st->bufsize) == -1) {
+    c2G4_dev_st->ongoing = Nothing_2G4;
+    c2G4_dev_st->rx_multi = false;
+    return -1;
+  }
+  if (c2G4_dev_st->rx_multi_tag_s->n_left > 0) {
+    c2G4_dev_st->ongoing = Rx_Multi_2G4;
+  } else {
+    c2G4_dev_st->ongoing = Nothing_2G4;
+    c2G4_dev_st->rx_multi = false;
+  }
+  return header;
+}
+
 /**
  * Continue reception after an address evaluation request
  *  bool dev_accepts defines if the device accepts the packet or not
@@ -347,14 +579,16 @@ int p2G4_dev_rx_cont_after_addr_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, bool
   } else {
     header = P2G4_MSG_RXSTOP;
   }
-  write(p2G4_dev_state->pb_dev_state.ff_dtp, &header, sizeof(header));
+  p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
 
   if (!dev_accepts) {
     p2G4_dev_state->ongoing = Nothing_2G4;
+    p2G4_dev_state->txrx_done_s = NULL;
+    p2G4_dev_state->rx_chain_done_s = NULL;
     return 0;
   }
 
-  if (pb_dev_read(&p2G4_dev_state->pb_dev_state, &header, sizeof(header)) == -1) {
+  if (p2G4_dev_read_header_i(&p2G4_dev_state->io, &header) == -1) {
     return -1;
   }
 
@@ -385,22 +619,35 @@ int p2G4_dev_rxv2_cont_after_addr_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, bo
 
   if (dev_accepts) {
     header = P2G4_MSG_RXV2CONT;
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, &header, sizeof(header));
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, abort, sizeof(p2G4_abort_t));
+    p2G4_dev_send_msg_i(&p2G4_dev_state->io, header, abort, sizeof(p2G4_abort_t));
+  } else if (p2G4_dev_state->rx_stream) {
+    header = P2G4_MSG_RX_STREAM_SKIP;
+    p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
   } else {
     header = P2G4_MSG_RXSTOP;
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, &header, sizeof(header));
+    p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
   }
 
   if (!dev_accepts) {
-    p2G4_dev_state->ongoing = Nothing_2G4;
+    if (p2G4_dev_state->rx_stream) {
+      /* The stream continues, the device shall call p2G4_dev_rx_stream_next_s_nc_b() */
+      p2G4_dev_state->WeGotAddress = false;
+      p2G4_dev_state->ongoing = Rx_Stream_2G4;
+    } else {
+      p2G4_dev_state->ongoing = Nothing_2G4;
+      p2G4_dev_state->txrx_done_s = NULL;
+      p2G4_dev_state->rx_chain_done_s = NULL;
+    }
     return 0;
   }
 
-  if (pb_dev_read(&p2G4_dev_state->pb_dev_state, &header, sizeof(header)) == -1) {
+  if (p2G4_dev_read_header_i(&p2G4_dev_state->io, &header) == -1) {
     return -1;
   }
 
+  if (p2G4_dev_state->rx_stream) {
+    return c2G4_handle_rx_stream_responses_s_nc(p2G4_dev_state, header);
+  }
   return c2G4_handle_rxv2_responses_s_nc(p2G4_dev_state, header);
 }
 
@@ -421,10 +668,10 @@ int p2G4_dev_provide_new_rx_abort_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2
   }
   pc_header_t header;
 
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp, P2G4_MSG_RERESP_ABORTREEVAL,
-      (void *)abort,  sizeof(p2G4_abort_t));
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_RERESP_ABORTREEVAL,
+                      (void *)abort,  sizeof(p2G4_abort_t));
 
-  if (pb_dev_read(&p2G4_dev_state->pb_dev_state, &header, sizeof(header)) == -1) {
+  if (p2G4_dev_read_header_i(&p2G4_dev_state->io, &header) == -1) {
     return -1;
   }
 
@@ -447,13 +694,19 @@ int p2G4_dev_provide_new_rxv2_abort_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state,
   }
   pc_header_t header;
 
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp, P2G4_MSG_RERESP_ABORTREEVAL,
-      (void *)abort,  sizeof(p2G4_abort_t));
+  p2G4_dev_send_msg_i(&p2G4_dev_state->io, P2G4_MSG_RERESP_ABORTREEVAL,
+                      (void *)abort,  sizeof(p2G4_abort_t));
 
-  if (pb_dev_read(&p2G4_dev_state->pb_dev_state, &header, sizeof(header)) == -1) {
+  if (p2G4_dev_read_header_i(&p2G4_dev_state->io, &header) == -1) {
     return -1;
   }
 
+  if (p2G4_dev_state->rx_stream) {
+    return c2G4_handle_rx_stream_responses_s_nc(p2G4_dev_state, header);
+  }
+  if (p2G4_dev_state->rx_multi) {
+    return c2G4_handle_rx_multi_responses_s_nc(p2G4_dev_state, header);
+  }
   return c2G4_handle_rxv2_responses_s_nc(p2G4_dev_state, header);
 }
 
@@ -467,9 +720,9 @@ int p2G4_dev_req_imm_RSSI_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssiv2_t
   if (p2G4_dev_st->ongoing != Rx_Abort_Reeval_2G4) {
     bs_trace_error_time_line("Tried to send a new Rx RSSI immediate request but we are not in a Rx transaction abort reevaluation!\n");
   }
-  pb_send_msg(p2G4_dev_st->pb_dev_state.ff_dtp,
-              P2G4_MSG_RERESP_IMMRSSI, (void *)RSSI_s,  sizeof(p2G4_rssiv2_t));
-  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_st->pb_dev_state, RSSI_done_s);
+  p2G4_dev_send_msg_i(&p2G4_dev_st->io,
+                      P2G4_MSG_RERESP_IMMRSSI, (void *)RSSI_s,  sizeof(p2G4_rssiv2_t));
+  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_st->io, RSSI_done_s);
 }
 
 /**
@@ -479,9 +732,9 @@ int p2G4_dev_req_imm_RSSI_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssiv2_t
  */
 int p2G4_dev_req_RSSI_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssi_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s){
   CHECK_CONNECTED(p2G4_dev_st->pb_dev_state.connected);
-  pb_send_msg(p2G4_dev_st->pb_dev_state.ff_dtp,
-              P2G4_MSG_RSSIMEAS, (void *)RSSI_s, sizeof(p2G4_rssi_t));
-  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_st->pb_dev_state, RSSI_done_s);
+  p2G4_dev_send_msg_i(&p2G4_dev_st->io,
+                      P2G4_MSG_RSSIMEAS, (void *)RSSI_s, sizeof(p2G4_rssi_t));
+  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_st->io, RSSI_done_s);
 }
 
 /**
@@ -491,9 +744,23 @@ int p2G4_dev_req_RSSI_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssi_t *RSSI
  */
 int p2G4_dev_req_RSSIv2_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssiv2_t *RSSI_s, p2G4_rssi_done_t *RSSI_done_s){
   CHECK_CONNECTED(p2G4_dev_st->pb_dev_state.connected);
-  pb_send_msg(p2G4_dev_st->pb_dev_state.ff_dtp,
-              P2G4_MSG_RSSIV2MEAS, (void *)RSSI_s, sizeof(p2G4_rssiv2_t));
-  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_st->pb_dev_state, RSSI_done_s);
+  p2G4_dev_send_msg_i(&p2G4_dev_st->io,
+                      P2G4_MSG_RSSIV2MEAS, (void *)RSSI_s, sizeof(p2G4_rssiv2_t));
+  return p2G4_dev_get_rssi_resp_i(&p2G4_dev_st->io, RSSI_done_s);
+}
+
+/**
+ * Request a sweep of RSSI measurements over several frequencies to the phy
+ * (see p2G4_rssi_sweep_t)
+ * rssi needs to be an array of sweep_s->n_points elements, allocated by the caller
+ *
+ * returns -1 if disconnected, 0 otherwise
+ */
+int p2G4_dev_req_rssi_sweep_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssi_sweep_t *sweep_s,
+                                   p2G4_freq2_t *freqs, p2G4_rssi_power_t *rssi){
+  CHECK_CONNECTED(p2G4_dev_st->pb_dev_state.connected);
+  p2G4_dev_req_rssi_sweep_i(&p2G4_dev_st->io, sweep_s, freqs);
+  return p2G4_dev_get_rssi_sweep_resp_i(&p2G4_dev_st->io, rssi, sweep_s->n_points);
 }
 
 /**
@@ -503,6 +770,8 @@ int p2G4_dev_req_RSSIv2_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_st, p2G4_rssiv2_t *
  * The buffer shall have buf_size bytes.
  * If buf_size is 0, this function will allocate a new buffer and point
  *  *RxBuf to it (the application must free it afterwards).
+ * If buf_size is P2G4_RXBUF_FROM_POOL, the buffer will be taken from this
+ * connection pool, and shall be given back with p2G4_dev_rx_pool_release_s_nc().
  * Otherwise this function will fail if the buffer is to small to read the
  * incoming packet
  *
@@ -515,18 +784,19 @@ int p2G4_dev_req_rx_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_t *rx_s,
     bs_trace_error_time_line("Tried to request a new Rx while another transaction was ongoing\n");
   }
 
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp, P2G4_MSG_RX,
-              (void *)rx_s,  sizeof(p2G4_rx_t));
+  p2G4_dev_req_rx_i(&p2G4_dev_state->io, rx_s);
 
   p2G4_dev_state->bufsize = buf_size;
   p2G4_dev_state->rxbuf   = rx_buf;
   p2G4_dev_state->rx_done_s = rx_done_s;
+  p2G4_dev_state->txrx_done_s = NULL;
+  p2G4_dev_state->rx_chain_done_s = NULL;
   p2G4_dev_state->WeGotAddress = false;
 
   pc_header_t header;
   int ret;
 
-  ret = pb_dev_read(&p2G4_dev_state->pb_dev_state, &header, sizeof(header));
+  ret = p2G4_dev_read_header_i(&p2G4_dev_state->io, &header);
   if (ret==-1)
     return -1;
 
@@ -540,6 +810,8 @@ int p2G4_dev_req_rx_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_t *rx_s,
  * The buffer shall have buf_size bytes.
  * If buf_size is 0, this function will allocate a new buffer and point
  *  *RxBuf to it (the application must free it afterwards).
+ * If buf_size is P2G4_RXBUF_FROM_POOL, the buffer will be taken from this
+ * connection pool, and shall be given back with p2G4_dev_rx_pool_release_s_nc().
  * Otherwise this function will fail if the buffer is to small to read the
  * incoming packet
  *
@@ -552,21 +824,19 @@ int p2G4_dev_req_rxv2_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rxv2_t *r
     bs_trace_error_time_line("Tried to request a new Rx while another transaction was ongoing\n");
   }
 
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp, P2G4_MSG_RXV2,
-              (void *)rx_s,  sizeof(p2G4_rxv2_t));
-  if (rx_s->n_addr > 0) {
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, phy_addr, sizeof(p2G4_address_t)*rx_s->n_addr);
-  }
+  p2G4_dev_req_rxv2_i(&p2G4_dev_state->io, rx_s, phy_addr);
 
   p2G4_dev_state->bufsize = buf_size;
   p2G4_dev_state->rxbuf   = rx_buf;
   p2G4_dev_state->rxv2_done_s = rx_done_s;
+  p2G4_dev_state->txrx_done_s = NULL;
+  p2G4_dev_state->rx_chain_done_s = NULL;
   p2G4_dev_state->WeGotAddress = false;
 
   pc_header_t header;
   int ret;
 
-  ret = pb_dev_read(&p2G4_dev_state->pb_dev_state, &header, sizeof(header));
+  ret = p2G4_dev_read_header_i(&p2G4_dev_state->io, &header);
   if (ret==-1)
     return -1;
 
@@ -580,6 +850,8 @@ int p2G4_dev_req_rxv2_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rxv2_t *r
  * The buffer shall have buf_size bytes.
  * If buf_size is 0, this function will allocate a new buffer and point
  *  *RxBuf to it (the application must free it afterwards).
+ * If buf_size is P2G4_RXBUF_FROM_POOL, the buffer will be taken from this
+ * connection pool, and shall be given back with p2G4_dev_rx_pool_release_s_nc().
  * Otherwise this function will fail if the buffer is to small to read the
  * incoming packet
  *
@@ -592,24 +864,511 @@ int p2G4_dev_req_rx2v1_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx2v1_t
     bs_trace_error_time_line("Tried to request a new Rx while another transaction was ongoing\n");
   }
 
-  pb_send_msg(p2G4_dev_state->pb_dev_state.ff_dtp, P2G4_MSG_RX2V1,
-              (void *)rx_s, sizeof(p2G4_rx2v1_t));
-  if (rx_s->n_addr > 0) {
-    write(p2G4_dev_state->pb_dev_state.ff_dtp, phy_addr, sizeof(p2G4_address_t)*rx_s->n_addr);
-  }
+  p2G4_dev_req_rx2v1_i(&p2G4_dev_state->io, rx_s, phy_addr);
 
   p2G4_dev_state->bufsize = buf_size;
   p2G4_dev_state->rxbuf   = rx_buf;
   p2G4_dev_state->rxv2_done_s = rx_done_s;
+  p2G4_dev_state->txrx_done_s = NULL;
+  p2G4_dev_state->rx_chain_done_s = NULL;
   p2G4_dev_state->WeGotAddress = false;
 
   pc_header_t header;
   int ret;
 
-  ret = pb_dev_read(&p2G4_dev_state->pb_dev_state, &header, sizeof(header));
+  ret = p2G4_dev_read_header_i(&p2G4_dev_state->io, &header);
   if (ret==-1) {
     return -1;
   }
 
   return c2G4_handle_rxv2_responses_s_nc(p2G4_dev_state, header);
 }
+
+/**
+ * Request a chained reception to the phy: a v2.1 reception followed by
+ * the prelocked reception of each of the next segments of the same packet
+ * (for ex. the FEC2 part of a Coded Phy packet), as one transaction
+ * (see p2G4_rx_chain_t)
+ *
+ * The payload of all segments is placed, one after the other, in one buffer
+ * (rx_buf and buf_size are as for p2G4_dev_req_rx2v1_s_nc_b())
+ * done_s is filled with the overall result and the status of each segment
+ *
+ * returns -1 on error, otherwise the response from the phy.
+ * Possible phy responses are:
+ *   * P2G4_MSG_RX_CHAIN_END : (updates done_s)
+ *        The transaction has terminated, the device may start a new transaction
+ *   * P2G4_MSG_ABORTREEVAL
+ *        The device shall call p2G4_dev_provide_new_rxv2_abort_s_nc_b() with a new abort structure
+ */
+int p2G4_dev_req_rx_chain_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_chain_t *chain,
+                                 p2G4_rx2v1_t *rx_s, p2G4_address_t *phy_addr,
+                                 p2G4_rx_chain_seg_t *segs, p2G4_rx_chain_done_t *done_s,
+                                 uint8_t **rx_buf, size_t buf_size) {
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ( p2G4_dev_state->ongoing != Nothing_2G4 ) {
+    bs_trace_error_time_line("Tried to request a new Rx while another transaction was ongoing\n");
+  }
+
+  p2G4_dev_req_rx_chain_i(&p2G4_dev_state->io, chain, rx_s, phy_addr, segs);
+
+  p2G4_dev_state->bufsize = buf_size;
+  p2G4_dev_state->rxbuf   = rx_buf;
+  p2G4_dev_state->rxv2_done_s = &done_s->rx;
+  p2G4_dev_state->rx_chain_done_s = done_s;
+  p2G4_dev_state->txrx_done_s = NULL;
+  p2G4_dev_state->WeGotAddress = false;
+
+  pc_header_t header;
+  int ret;
+
+  ret = p2G4_dev_read_header_i(&p2G4_dev_state->io, &header);
+  if (ret==-1) {
+    return -1;
+  }
+
+  return c2G4_handle_rxv2_responses_s_nc(p2G4_dev_state, header);
+}
+
+/**
+ * Start handling the phy responses to a P2G4_MSG_TXRX or P2G4_MSG_RX_AUTORESP
+ * (both end with a P2G4_MSG_TXRX_END)
+ */
+static int c2G4_txrx_start_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state,
+                                p2G4_txrx_done_t *done_s, uint8_t **rx_buf, size_t buf_size) {
+  p2G4_dev_state->bufsize = buf_size;
+  p2G4_dev_state->rxbuf   = rx_buf;
+  p2G4_dev_state->rxv2_done_s = &done_s->rx;
+  p2G4_dev_state->txrx_done_s = done_s;
+  p2G4_dev_state->rx_chain_done_s = NULL;
+  p2G4_dev_state->WeGotAddress = false;
+
+  pc_header_t header;
+  int ret;
+
+  ret = p2G4_dev_read_header_i(&p2G4_dev_state->io, &header);
+  if (ret==-1) {
+    return -1;
+  }
+
+  return c2G4_handle_rxv2_responses_s_nc(p2G4_dev_state, header);
+}
+
+/**
+ * Request a transmission followed by a reception to the phy, as one transaction
+ * (see p2G4_txrx_t)
+ *
+ * packet is the Tx payload, and rx_buf and buf_size are as for
+ * p2G4_dev_req_rx2v1_s_nc_b()
+ * done_s is filled with the result of both the Tx and the Rx
+ *
+ * returns -1 on error, the received response header >=0 otherwise.
+ * The responses are handled as for p2G4_dev_req_rx2v1_s_nc_b(), but the
+ * transaction ends with a P2G4_MSG_TXRX_END instead of a P2G4_MSG_RXV2_END
+ */
+int p2G4_dev_req_txrx_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_txrx_t *txrx_s,
+                             p2G4_address_t *phy_addr, uint8_t *packet,
+                             p2G4_txrx_done_t *done_s, uint8_t **rx_buf, size_t buf_size) {
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ( p2G4_dev_state->ongoing != Nothing_2G4 ) {
+    bs_trace_error_time_line("Tried to request a new Tx/Rx while another transaction was ongoing\n");
+  }
+
+  p2G4_dev_req_txrx_i(&p2G4_dev_state->io, txrx_s, phy_addr, packet);
+  p2G4_dev_txrx_tx_done_i(txrx_s, done_s);
+
+  return c2G4_txrx_start_s_nc(p2G4_dev_state, done_s, rx_buf, buf_size);
+}
+
+/**
+ * Request a reception, followed by an automatic response transmission if the
+ * received packet meets the condition, to the phy, as one transaction
+ * (see p2G4_rx_autoresp_t)
+ *
+ * rules are the n_rules condition rules, packet the response payload,
+ * and rx_buf and buf_size are as for p2G4_dev_req_rx2v1_s_nc_b()
+ * done_s is filled with the result of both the Rx and the Tx
+ *
+ * returns -1 on error, the received response header >=0 otherwise.
+ * The responses are handled as for p2G4_dev_req_txrx_s_nc_b()
+ */
+int p2G4_dev_req_rx_autoresp_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_autoresp_t *ar_s,
+                                    p2G4_address_t *phy_addr, p2G4_rx_filter_rule_t *rules,
+                                    uint8_t *packet, p2G4_txrx_done_t *done_s,
+                                    uint8_t **rx_buf, size_t buf_size) {
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ( p2G4_dev_state->ongoing != Nothing_2G4 ) {
+    bs_trace_error_time_line("Tried to request a new Tx/Rx while another transaction was ongoing\n");
+  }
+
+  p2G4_dev_req_rx_autoresp_i(&p2G4_dev_state->io, ar_s, phy_addr, rules, packet);
+  p2G4_dev_rx_autoresp_tx_done_i(done_s);
+
+  return c2G4_txrx_start_s_nc(p2G4_dev_state, done_s, rx_buf, buf_size);
+}
+
+/**
+ * Request a streaming reception to the phy
+ *
+ * The stream receives packet after packet until aborted or until
+ * rx_s->end_time. Each packet is delivered as for p2G4_dev_req_rxv2_s_nc_b()
+ * thru rx_done_s and rx_buf
+ * (Note that with buf_size == 0 each packet gets a new buffer)
+ *
+ * returns -1 on error, otherwise the response from the phy:
+ *   * P2G4_MSG_RX_STREAM_PACKET: (updates rx_done_s and *rx_buf)
+ *        One reception ended. The device shall call p2G4_dev_rx_stream_next_s_nc_b()
+ *        to continue, or p2G4_dev_rx_stream_stop_s_nc_b() to end the stream
+ *   * P2G4_MSG_RXV2_ADDRESSFOUND: (only if rx_s->auto_accept == 0)
+ *        The device shall call p2G4_dev_rxv2_cont_after_addr_s_nc_b().
+ *        If it rejects the packet (which is then skipped), it shall call
+ *        p2G4_dev_rx_stream_next_s_nc_b() after
+ *   * P2G4_MSG_ABORTREEVAL
+ *        The device shall call p2G4_dev_provide_new_rxv2_abort_s_nc_b()
+ *   * P2G4_MSG_RX_STREAM_END: (updates rx_done_s)
+ *        The stream is over
+ */
+int p2G4_dev_req_rx_stream_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_stream_t *rx_s,
+                                  p2G4_address_t *phy_addr, p2G4_freq2_t *channels,
+                                  p2G4_rxv2_done_t *rx_done_s, uint8_t **rx_buf, size_t buf_size) {
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ( p2G4_dev_state->ongoing != Nothing_2G4 ) {
+    bs_trace_error_time_line("Tried to request a new Rx while another transaction was ongoing\n");
+  }
+
+  p2G4_dev_req_rx_stream_i(&p2G4_dev_state->io, rx_s, phy_addr, channels);
+
+  p2G4_dev_state->bufsize = buf_size;
+  p2G4_dev_state->rxbuf   = rx_buf;
+  p2G4_dev_state->rxv2_done_s = rx_done_s;
+  p2G4_dev_state->txrx_done_s = NULL;
+  p2G4_dev_state->rx_chain_done_s = NULL;
+  p2G4_dev_state->WeGotAddress = false;
+  p2G4_dev_state->rx_stream = true;
+  p2G4_dev_state->rx_stream_packet = false;
+  p2G4_dev_state->ongoing = Rx_Stream_2G4;
+
+  return p2G4_dev_rx_stream_next_s_nc_b(p2G4_dev_state);
+}
+
+/**
+ * Wait for the next event of an ongoing reception stream
+ * (see p2G4_dev_req_rx_stream_s_nc_b() for the possible responses)
+ * After a P2G4_MSG_RX_STREAM_PACKET, this tells the phy to continue the stream
+ */
+int p2G4_dev_rx_stream_next_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state) {
+  pc_header_t header;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ( p2G4_dev_state->ongoing != Rx_Stream_2G4 ) {
+    bs_trace_error_time_line("Tried to continue an Rx stream, but we are not in one now..\n");
+  }
+
+  if (p2G4_dev_state->rx_stream_packet) {
+    header = P2G4_MSG_RX_STREAM_CONT;
+    p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
+    p2G4_dev_state->rx_stream_packet = false;
+  }
+
+  if (p2G4_dev_read_header_i(&p2G4_dev_state->io, &header) == -1) {
+    return -1;
+  }
+
+  return c2G4_handle_rx_stream_responses_s_nc(p2G4_dev_state, header);
+}
+
+/**
+ * End an ongoing reception stream, right after a P2G4_MSG_RX_STREAM_PACKET
+ * (at that packet end_time)
+ *
+ * returns -1 on error, otherwise the phy acknowledgement,
+ * P2G4_MSG_RX_STREAM_END (which updates rx_done_s)
+ */
+int p2G4_dev_rx_stream_stop_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state) {
+  pc_header_t header;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ((p2G4_dev_state->ongoing != Rx_Stream_2G4) || !p2G4_dev_state->rx_stream_packet) {
+    bs_trace_error_time_line("Tried to stop an Rx stream, but we are not right after one of its packets\n");
+  }
+
+  header = P2G4_MSG_RX_STREAM_STOP;
+  p2G4_dev_send_i(&p2G4_dev_state->io, &header, sizeof(header));
+  p2G4_dev_state->rx_stream_packet = false;
+
+  if (p2G4_dev_read_header_i(&p2G4_dev_state->io, &header) == -1) {
+    return -1;
+  }
+  if ((header != P2G4_MSG_RX_STREAM_END) && (header != PB_MSG_DISCONNECT)) {
+    INVALID_RESP(header);
+  }
+
+  return c2G4_handle_rx_stream_responses_s_nc(p2G4_dev_state, header);
+}
+
+/**
+ * Request a reception with several receivers at the same time (see p2G4_rx_multi_t)
+ *
+ * done_s and rx_bufs need to be arrays of multi_s->n_rx elements, allocated by
+ * the caller. As each receiver ends, its result and packet are placed in its
+ * element (each rx_bufs[i] and buf_size are as for p2G4_dev_req_rxv2_s_nc_b()),
+ * and tag_s is updated with its index and how many receivers are still ongoing
+ *
+ * returns -1 on error, otherwise the response from the phy:
+ *   * P2G4_MSG_RX_MULTI_END: (updates tag_s, done_s[tag_s->rx_idx] and rx_bufs[tag_s->rx_idx])
+ *        One receiver ended. If tag_s->n_left > 0, the device shall call
+ *        p2G4_dev_rx_multi_next_s_nc_b() to wait for the others.
+ *        Otherwise the request is over
+ *   * P2G4_MSG_ABORTREEVAL
+ *        The device shall call p2G4_dev_provide_new_rxv2_abort_s_nc_b()
+ */
+int p2G4_dev_req_rx_multi_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_multi_t *multi_s,
+                                 p2G4_rx2v1_t *rxs, p2G4_address_t *phy_addr,
+                                 p2G4_rxv2_done_t *done_s, p2G4_rx_multi_tag_t *tag_s,
+                                 uint8_t **rx_bufs, size_t buf_size) {
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ( p2G4_dev_state->ongoing != Nothing_2G4 ) {
+    bs_trace_error_time_line("Tried to request a new Rx while another transaction was ongoing\n");
+  }
+
+  p2G4_dev_req_rx_multi_i(&p2G4_dev_state->io, multi_s, rxs, phy_addr);
+
+  p2G4_dev_state->bufsize = buf_size;
+  p2G4_dev_state->rxbuf   = rx_bufs;
+  p2G4_dev_state->rxv2_done_s = done_s;
+  p2G4_dev_state->txrx_done_s = NULL;
+  p2G4_dev_state->rx_chain_done_s = NULL;
+  p2G4_dev_state->rx_multi_tag_s = tag_s;
+  p2G4_dev_state->rx_multi_n = multi_s->n_rx;
+  p2G4_dev_state->rx_multi = true;
+  p2G4_dev_state->ongoing = Rx_Multi_2G4;
+
+  return p2G4_dev_rx_multi_next_s_nc_b(p2G4_dev_state);
+}
+
+/**
+ * Wait for the next event of an ongoing multi-receiver reception
+ * (see p2G4_dev_req_rx_multi_s_nc_b() for the possible responses)
+ */
+int p2G4_dev_rx_multi_next_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state) {
+  pc_header_t header;
+
+  CHECK_CONNECTED(p2G4_dev_state->pb_dev_state.connected);
+
+  if ( p2G4_dev_state->ongoing != Rx_Multi_2G4 ) {
+    bs_trace_error_time_line("Tried to continue a multi-receiver Rx, but we are not in one now..\n");
+  }
+
+  if (p2G4_dev_read_header_i(&p2G4_dev_state->io, &header) == -1) {
+    return -1;
+  }
+
+  return c2G4_handle_rx_multi_responses_s_nc(p2G4_dev_state, header);
+}
+
+/**
+ * Provide the phy a schedule of abort substructures for the next Tx, Rx or
+ * CCA request, to be used, in order, each time the current recheck_time is
+ * reached, instead of asking the device.
+ * Only once all <n_steps> are used, the phy will request an abort
+ * reevaluation as usual.
+ * It is sent to the phy with the next request, which shall be a Tx, Rx or CCA.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_abort_sched_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_abort_t *steps, uint n_steps){
+  if (p2G4_dev_state->ongoing != Nothing_2G4) {
+    bs_trace_error_time_line("Tried to provide an abort schedule while a transaction was ongoing\n");
+  }
+  return p2G4_dev_set_abort_sched_i(&p2G4_dev_state->io, steps, n_steps);
+}
+
+/**
+ * Provide the phy a header filter for the next v2/v2.1 Rx request, so it
+ * accepts or rejects packets on its own instead of asking the device.
+ * With filter->ask_device == 0, the device is only informed at the end of the
+ * reception (so its header evaluation is not used)
+ * It is sent to the phy with the next request, which shall be a v2/v2.1 Rx.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_rx_filter_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_filter_t *filter,
+                                p2G4_rx_filter_rule_t *rules){
+  if (p2G4_dev_state->ongoing != Nothing_2G4) {
+    bs_trace_error_time_line("Tried to provide an Rx filter while a transaction was ongoing\n");
+  }
+  return p2G4_dev_set_rx_filter_i(&p2G4_dev_state->io, filter, rules);
+}
+
+/**
+ * Request RSSI samples to be taken during the next v2/v2.1 Rx request
+ * (see p2G4_rssi_series_t). Get them with p2G4_dev_rx_get_rssi_samples_s_nc()
+ * once the reception ends.
+ * It is sent to the phy with the next request, which shall be a v2/v2.1 Rx.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_rx_rssi_series_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rssi_series_t *series){
+  if (p2G4_dev_state->ongoing != Nothing_2G4) {
+    bs_trace_error_time_line("Tried to provide an Rx RSSI series while a transaction was ongoing\n");
+  }
+  return p2G4_dev_set_rx_rssi_series_i(&p2G4_dev_state->io, series);
+}
+
+/**
+ * Register in the phy a set of <n_addr> addresses (which may be more than
+ * P2G4_RXV2_MAX_ADDRESSES) to be used by later Rx requests,
+ * (see p2G4_dev_set_rx_addr_set_s_nc())
+ * It blocks until the phy accepts it, after which *handle is set to the set handle
+ *
+ * returns -1 on error or if the phy rejected the set, 0 otherwise
+ */
+int p2G4_dev_addr_set_register_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_address_t *addr,
+                                    uint32_t n_addr, uint32_t *handle){
+  if (p2G4_dev_state->ongoing != Nothing_2G4) {
+    bs_trace_error_time_line("Tried to register an address set while a transaction was ongoing\n");
+  }
+  return p2G4_dev_addr_set_register_i(&p2G4_dev_state->io, addr, n_addr, handle);
+}
+
+/**
+ * Release an address set registered with p2G4_dev_addr_set_register_s_nc()
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_addr_set_release_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, uint32_t handle){
+  return p2G4_dev_addr_set_release_i(&p2G4_dev_state->io, handle);
+}
+
+/**
+ * Make the next v2/v2.1 Rx request also match the addresses in the registered
+ * set <handle> (besides the addresses in the request itself)
+ * It is sent to the phy with the next request, which shall be a v2/v2.1 Rx.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_set_rx_addr_set_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, uint32_t handle){
+  if (p2G4_dev_state->ongoing != Nothing_2G4) {
+    bs_trace_error_time_line("Tried to select an address set while a transaction was ongoing\n");
+  }
+  return p2G4_dev_set_rx_addr_set_i(&p2G4_dev_state->io, handle);
+}
+
+/**
+ * Register a base Tx (v2.1) request, to be used as template for later
+ * requests (see p2G4_dev_use_tmpl_s_nc())
+ * *handle is set to the template handle
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_tmpl_register_tx2v1_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_tx2v1_t *tx_s,
+                                      uint32_t *handle){
+  return p2G4_dev_tmpl_register_i(&p2G4_dev_state->io, P2G4_MSG_TX2V1, tx_s, NULL, handle);
+}
+
+/**
+ * Register a base Rx (v2.1) request (and its addresses), to be used as
+ * template for later requests (see p2G4_dev_use_tmpl_s_nc())
+ * *handle is set to the template handle
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_tmpl_register_rx2v1_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx2v1_t *rx_s,
+                                      p2G4_address_t *phy_addr, uint32_t *handle){
+  return p2G4_dev_tmpl_register_i(&p2G4_dev_state->io, P2G4_MSG_RX2V1, rx_s, phy_addr, handle);
+}
+
+/**
+ * Send the next Tx or Rx (v2.1) request based on the template <handle>:
+ * If the request only differs from the template in its start time, center
+ * frequency and/or abort, only those are sent to the phy. Otherwise the
+ * request is sent in full, as usual.
+ * Shall be called right before the request it applies to.
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_use_tmpl_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, uint32_t handle){
+  if (p2G4_dev_state->ongoing != Nothing_2G4) {
+    bs_trace_error_time_line("Tried to select a template while a transaction was ongoing\n");
+  }
+  return p2G4_dev_use_tmpl_i(&p2G4_dev_state->io, handle);
+}
+
+/**
+ * Fetch <size> bytes, starting at <offset>, of the payload of the packet
+ * being (before continuing after an address found) or last received, into buf
+ * (For Rx requests with resp_type P2G4_RESP_PAYLOAD_NONE/HEADER)
+ *
+ * returns -1 on error, the number of bytes copied otherwise (less than
+ * requested if the packet is shorter)
+ */
+int p2G4_dev_rx_fetch_payload_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, uint16_t offset,
+                                   uint16_t size, uint8_t *buf){
+  if ((p2G4_dev_state->ongoing != Nothing_2G4)
+      && (p2G4_dev_state->ongoing != Rx_Header_Eval_2G4)) {
+    bs_trace_error_time_line("Tried to fetch a packet payload while the phy was not waiting for it\n");
+  }
+  return p2G4_dev_rx_fetch_payload_i(&p2G4_dev_state->io, offset, size, buf);
+}
+
+/**
+ * Get the progress of the packet being received in P2G4_RESP_PAYLOAD_CHUNKED
+ * mode (for ex. during an abort reevaluation)
+ * The bytes [0, progress->received) are already in the reception buffer
+ */
+void p2G4_dev_rx_get_progress_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_progress_t *progress){
+  *progress = p2G4_dev_state->io.rx_progress;
+}
+
+/**
+ * During a Rx abort reevaluation or header evaluation, request from the phy
+ * the bit error mask of the packet being received, from <start_bit> on
+ * (the device already has the runs before it).
+ * It can then be read with p2G4_dev_rx_get_error_mask_s_nc()
+ *
+ * returns -1 on error, 0 otherwise
+ */
+int p2G4_dev_req_imm_error_mask_s_nc_b(p2G4_dev_state_nc_t *p2G4_dev_state, uint32_t start_bit){
+  if ((p2G4_dev_state->ongoing != Rx_Abort_Reeval_2G4)
+      && (p2G4_dev_state->ongoing != Rx_Header_Eval_2G4)) {
+    bs_trace_error_time_line("Tried to request an error mask but we are not in a Rx abort reevaluation or header evaluation!\n");
+  }
+  return p2G4_dev_imm_req_error_mask_i(&p2G4_dev_state->io, start_bit);
+}
+
+/**
+ * Get the bit error mask of the packet being/last received
+ * (see P2G4_RESP_ERROR_MASK and p2G4_rx_apply_error_mask())
+ */
+void p2G4_dev_rx_get_error_mask_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_error_mask_t *mask){
+  p2G4_dev_rx_get_error_mask_i(&p2G4_dev_state->io, mask);
+}
+
+/**
+ * Get the RSSI samples taken during the last reception
+ * (see p2G4_dev_set_rx_rssi_series_s_nc())
+ */
+void p2G4_dev_rx_get_rssi_samples_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_rssi_samples_t *samples){
+  p2G4_dev_rx_get_rssi_samples_i(&p2G4_dev_state->io, samples);
+}
+
+/**
+ * Give back a reception buffer obtained with buf_size = P2G4_RXBUF_FROM_POOL
+ */
+void p2G4_dev_rx_pool_release_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, uint8_t *buf){
+  p2G4_rx_pool_release(&p2G4_dev_state->io.rx_pool, buf);
+}
+
+/**
+ * Get the reception buffer pool statistics (hits/misses)
+ */
+void p2G4_dev_rx_pool_get_stats_s_nc(p2G4_dev_state_nc_t *p2G4_dev_state, p2G4_rx_pool_stats_t *stats){
+  p2G4_rx_pool_get_stats(&p2G4_dev_state->io.rx_pool, stats);
+}
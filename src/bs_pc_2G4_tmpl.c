@@ -0,0 +1,226 @@
+/*
+ * Copyright 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Per connection request templates (see P2G4_MSG_TMPL_REGISTER)
+ *
+ * The device registers a base Tx2v1 or Rx2v1 request once. After selecting it
+ * with p2G4_dev_use_tmpl_*(), the next request of the same type is compared
+ * with the base, and if it only differs in its start time, center frequency
+ * and/or abort, only those are sent (P2G4_MSG_TMPL_INST).
+ * Otherwise the full request is sent as usual.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include "bs_tracing.h"
+#include "bs_oswrap.h"
+#include "bs_pc_2G4_priv.h"
+
+typedef struct p2G4_tmpl_s {
+  /* P2G4_MSG_TX2V1 or P2G4_MSG_RX2V1 */
+  pc_header_t req;
+  union {
+    p2G4_tx2v1_t tx;
+    p2G4_rx2v1_t rx;
+  } base;
+  p2G4_address_t phy_addr[P2G4_RXV2_MAX_ADDRESSES];
+} p2G4_tmpl_entry_t;
+
+/**
+ * Register a template for later P2G4_MSG_TX2V1 or P2G4_MSG_RX2V1 (<req>)
+ * requests. <s> points to the base p2G4_tx2v1_t or p2G4_rx2v1_t,
+ * and (for Rx) phy_addr to its addresses.
+ * *handle is set to the template handle
+ */
+int p2G4_dev_tmpl_register_i(p2G4_dev_io_t *io, pc_header_t req, void *s,
+                             p2G4_address_t *phy_addr, uint32_t *handle) {
+  p2G4_tmpl_entry_t *entry;
+  p2G4_tmpl_t tmpl;
+  size_t size;
+  size_t n_addr = 0;
+
+  CHECK_CONNECTED(io->pb_dev_state->connected);
+
+  io->tmpls = bs_realloc(io->tmpls, (io->n_tmpls + 1)*sizeof(p2G4_tmpl_entry_t));
+  entry = &io->tmpls[io->n_tmpls++];
+  memset(entry, 0, sizeof(p2G4_tmpl_entry_t));
+  entry->req = req;
+
+  if (req == P2G4_MSG_TX2V1) {
+    size = sizeof(p2G4_tx2v1_t);
+  } else if (req == P2G4_MSG_RX2V1) {
+    size = sizeof(p2G4_rx2v1_t);
+    n_addr = ((p2G4_rx2v1_t *)s)->n_addr;
+    if (n_addr > P2G4_RXV2_MAX_ADDRESSES) {
+      bs_trace_error_line("Too many addresses in template (%u)\n", (uint)n_addr);
+    }
+    memcpy(entry->phy_addr, phy_addr, n_addr*sizeof(p2G4_address_t));
+  } else {
+    bs_trace_error_line("Templates are not supported for request type 0x%X\n", req);
+    return -1;
+  }
+  memcpy(&entry->base, s, size);
+
+  tmpl.handle = io->n_tmpls;
+  tmpl.req = req;
+  {
+    pc_header_t header = P2G4_MSG_TMPL_REGISTER;
+    struct iovec iov[4] = {
+      {.iov_base = &header, .iov_len = sizeof(header)},
+      {.iov_base = &tmpl, .iov_len = sizeof(p2G4_tmpl_t)},
+      {.iov_base = &entry->base, .iov_len = size},
+      {.iov_base = entry->phy_addr, .iov_len = n_addr*sizeof(p2G4_address_t)},
+    };
+    p2G4_dev_sendv_i(io, iov, n_addr > 0 ? 4 : 3);
+  }
+
+  *handle = tmpl.handle;
+  return 0;
+}
+
+/**
+ * Select the template <handle> for the next Tx2v1/Rx2v1 request
+ * That next request must be of the same type as the template (a Tx template
+ * followed by an Rx request, or the reverse, is an error)
+ */
+int p2G4_dev_use_tmpl_i(p2G4_dev_io_t *io, uint32_t handle) {
+  if ((handle == 0) || (handle > io->n_tmpls)) {
+    bs_trace_error_line("Unknown template handle (%u)\n", handle);
+  }
+  io->next_tmpl = handle;
+  return 0;
+}
+
+/**
+ * If a template was selected for this request, and the request only differs
+ * from it in fields which can be updated, send it as a template instantiation.
+ *
+ * <req> is the message which would be sent (P2G4_MSG_TX2V1,
+ * P2G4_MSG_TX2V1_POSTED or P2G4_MSG_RX2V1), <s> the request, <phy_addr> its
+ * addresses (Rx) and <payload> its packet (Tx)
+ *
+ * returns true if sent, false if the request shall be sent in full
+ */
+bool p2G4_dev_send_tmpl_i(p2G4_dev_io_t *io, pc_header_t req, void *s,
+                          p2G4_address_t *phy_addr, uint8_t *payload) {
+  p2G4_tmpl_entry_t *entry;
+  p2G4_tmpl_inst_t inst;
+  bs_time_t start, base_start;
+  p2G4_freq2_t freq, base_freq;
+  p2G4_abort_t *abort, *base_abort;
+  uint8_t fields[sizeof(bs_time_t) + sizeof(p2G4_freq2_t) + sizeof(p2G4_abort_t)];
+  size_t f_size = 0;
+  size_t p_size = 0;
+
+  if (io->next_tmpl == 0) {
+    return false;
+  }
+  entry = &io->tmpls[io->next_tmpl - 1];
+  inst.handle = io->next_tmpl;
+  inst.fields = 0;
+  io->next_tmpl = 0;
+
+  if (req == P2G4_MSG_TX2V1_POSTED) {
+    inst.fields |= P2G4_TMPL_POSTED;
+    req = P2G4_MSG_TX2V1;
+  }
+  if (req != entry->req) {
+    bs_trace_error_line("Template %u is for request type 0x%X, but the next "
+                        "request was of type 0x%X\n", inst.handle, entry->req, req);
+    return false;
+  }
+
+  if (req == P2G4_MSG_TX2V1) {
+    p2G4_tx2v1_t tx = *(p2G4_tx2v1_t *)s;
+    p2G4_tx2v1_t *base = &entry->base.tx;
+    bs_time_t delta = tx.start_tx_time - base->start_tx_time;
+
+    start = tx.start_tx_time;
+    base_start = base->start_tx_time;
+    freq = tx.radio_params.center_freq;
+    base_freq = base->radio_params.center_freq;
+    abort = &((p2G4_tx2v1_t *)s)->abort;
+    base_abort = &base->abort;
+    p_size = tx.packet_size;
+
+    /* Everything else must match the base, with all times shifted together */
+    tx.start_tx_time -= delta;
+    tx.start_packet_time -= delta;
+    tx.end_tx_time -= delta;
+    tx.end_packet_time -= delta;
+    tx.radio_params.center_freq = base->radio_params.center_freq;
+    tx.abort = base->abort;
+    if (memcmp(&tx, base, sizeof(p2G4_tx2v1_t)) != 0) {
+      return false;
+    }
+  } else {
+    p2G4_rx2v1_t rx = *(p2G4_rx2v1_t *)s;
+    p2G4_rx2v1_t *base = &entry->base.rx;
+
+    start = rx.start_time;
+    base_start = base->start_time;
+    freq = rx.radio_params.center_freq;
+    base_freq = base->radio_params.center_freq;
+    abort = &((p2G4_rx2v1_t *)s)->abort;
+    base_abort = &base->abort;
+
+    rx.start_time = base->start_time;
+    rx.radio_params.center_freq = base->radio_params.center_freq;
+    rx.abort = base->abort;
+    if ((memcmp(&rx, base, sizeof(p2G4_rx2v1_t)) != 0)
+        || ((rx.n_addr > 0)
+            && (memcmp(phy_addr, entry->phy_addr, rx.n_addr*sizeof(p2G4_address_t)) != 0))) {
+      return false;
+    }
+  }
+
+  if (start != base_start) {
+    inst.fields |= P2G4_TMPL_START;
+    memcpy(&fields[f_size], &start, sizeof(bs_time_t));
+    f_size += sizeof(bs_time_t);
+  }
+  if (freq != base_freq) {
+    inst.fields |= P2G4_TMPL_FREQ;
+    memcpy(&fields[f_size], &freq, sizeof(p2G4_freq2_t));
+    f_size += sizeof(p2G4_freq2_t);
+  }
+  if (memcmp(abort, base_abort, sizeof(p2G4_abort_t)) != 0) {
+    inst.fields |= P2G4_TMPL_ABORT;
+    memcpy(&fields[f_size], abort, sizeof(p2G4_abort_t));
+    f_size += sizeof(p2G4_abort_t);
+  }
+
+  {
+    pc_header_t header = P2G4_MSG_TMPL_INST;
+    struct iovec iov[4] = {
+      {.iov_base = &header, .iov_len = sizeof(header)},
+      {.iov_base = &inst, .iov_len = sizeof(p2G4_tmpl_inst_t)},
+      {.iov_base = fields, .iov_len = f_size},
+      {.iov_base = payload, .iov_len = p_size},
+    };
+    p2G4_dev_sendv_i(io, iov, p_size > 0 ? 4 : 3);
+  }
+  return true;
+}
+
+/**
+ * Request type (P2G4_MSG_TX2V1 or P2G4_MSG_RX2V1) of the template <handle>
+ */
+pc_header_t p2G4_tmpl_req_i(p2G4_dev_io_t *io, uint32_t handle) {
+  return io->tmpls[handle - 1].req;
+}
+
+/**
+ * Free all templates of this connection
+ */
+void p2G4_tmpl_free(p2G4_dev_io_t *io) {
+  free(io->tmpls);
+  io->tmpls = NULL;
+  io->n_tmpls = 0;
+  io->next_tmpl = 0;
+}
@@ -105,6 +105,32 @@ typedef struct __attribute__ ((packed)) {
  * its new functionality.
  ************************************************************/
 
+/*
+ * Bit error mask (resp_type bit 0)
+ *  If set, the phy sends the packet bit error mask in a P2G4_MSG_RX_ERROR_MASK
+ *  right before the P2G4_MSG_RXV2_END (or P2G4_MSG_RX_STREAM_PACKET)
+ */
+#define P2G4_RESP_ERROR_MASK     0x01
+
+/*
+ * Payload delivery options (resp_type bits 1-2)
+ *  FULL:   The whole packet follows the P2G4_MSG_RXV2_ADDRESSFOUND (or the
+ *          P2G4_MSG_RXV2_END if the phy filtered it, see P2G4_MSG_RX_FILTER)
+ *  NONE:   No payload is sent
+ *  HEADER: Only the first P2G4_RESP_HEADER_LEN() bytes are sent (where FULL
+ *          would send the whole packet)
+ *  CHUNKED: As HEADER, and then the rest is sent progressively, as it is
+ *          received, in P2G4_MSG_RX_CHUNK messages.
+ * The rest may be fetched with P2G4_MSG_RX_PAYLOAD_REQ (except in CHUNKED mode)
+ */
+#define P2G4_RESP_PAYLOAD_MASK   0x06
+#define P2G4_RESP_PAYLOAD_FULL   0x00
+#define P2G4_RESP_PAYLOAD_NONE   0x02
+#define P2G4_RESP_PAYLOAD_HEADER 0x04
+#define P2G4_RESP_PAYLOAD_CHUNKED 0x06
+#define P2G4_RESP_HEADER_LEN(n)  (((n) & 0xF) << 4)
+#define P2G4_RESP_GET_HEADER_LEN(resp_type) (((resp_type) >> 4) & 0xF)
+
 typedef struct __attribute__ ((packed)) {
   /* Absolute us when the receiver starts scanning */
   bs_time_t start_time;
@@ -380,7 +406,9 @@ typedef struct __attribute__ ((packed)) {
 
   /* Requested type of response
    *  * 0: Basic response
-   *  * (reserved) 1: Include also bit error mask
+   *  * Bit 0: Include also the bit error mask (P2G4_RESP_ERROR_MASK)
+   *  * Bits 1-2: Which part of the payload is sent (P2G4_RESP_PAYLOAD_*)
+   *  * Bits 4-7: Header length for P2G4_RESP_PAYLOAD_HEADER (P2G4_RESP_HEADER_LEN())
    *  * (reserved) all others
    */
   uint8_t resp_type;
@@ -633,7 +661,9 @@ typedef struct __attribute__ ((packed)) {
 
   /* Requested type of response
    *  * 0: Basic response
-   *  * (reserved) 1: Include also bit error mask
+   *  * Bit 0: Include also the bit error mask (P2G4_RESP_ERROR_MASK)
+   *  * Bits 1-2: Which part of the payload is sent (P2G4_RESP_PAYLOAD_*)
+   *  * Bits 4-7: Header length for P2G4_RESP_PAYLOAD_HEADER (P2G4_RESP_HEADER_LEN())
    *  * (reserved) all others
    */
   uint8_t resp_type;
@@ -737,6 +767,454 @@ typedef struct __attribute__ ((packed)) {
 } p2G4_cca_done_t;
 
 
+/*
+ * Streaming reception (see P2G4_MSG_RX_STREAM)
+ * One request which receives packet after packet, following a scan pattern,
+ * until aborted or until end_time
+ */
+typedef struct __attribute__ ((packed)) {
+  /* Reception parameters, used for every scan window
+   * rx.start_time is when the first window starts, rx.scan_duration is the
+   * duration of each window, and rx.abort applies to the whole stream.
+   * If n_channels > 0, rx.radio_params.center_freq is ignored */
+  p2G4_rx2v1_t rx;
+  /* Absolute us when the stream ends (TIME_NEVER: only when aborted) */
+  bs_time_t end_time;
+  /* In us, time between the start of consecutive scan windows
+   * (0 or <= rx.scan_duration: scan continuously) */
+  uint32_t scan_interval;
+  /* Evaluate the address and header automatically, as if the device always
+   * accepted (1), or send a P2G4_MSG_RXV2_ADDRESSFOUND for each packet and
+   * wait for a P2G4_MSG_RXCONT/RXV2CONT/RX_STREAM_SKIP (0) */
+  uint8_t auto_accept;
+  /* Also report scan windows which ended without sync (1) or not (0) */
+  uint8_t report_nosync;
+  /* Number of p2G4_freq2_t channels which follow the addresses.
+   * Scan window i is done in channel[i % n_channels] */
+  uint8_t n_channels;
+} p2G4_rx_stream_t;
+
+#define P2G4_ABORT_SCHED_MAX_STEPS 64
+
+typedef struct __attribute__ ((packed)) {
+  /* Number of p2G4_abort_t steps which follow (up to P2G4_ABORT_SCHED_MAX_STEPS) */
+  uint32_t n_steps;
+} p2G4_abort_sched_t;
+
+
+/*
+ * Reception header filter (see P2G4_MSG_RX_FILTER)
+ * Lets the phy accept or reject a packet on its own when its address and
+ * header are received, instead of asking the device
+ */
+#define P2G4_RX_FILTER_MAX_RULES 16
+
+typedef struct __attribute__ ((packed)) {
+  /* Accepted packet_size range (both included) */
+  uint16_t min_len;
+  uint16_t max_len;
+  /* Number of p2G4_rx_filter_rule_t which follow (all must match) */
+  uint8_t n_rules;
+  /* What to do with a packet which passes the filter:
+   * 0: accept it (the device is only informed at the end of the reception)
+   * 1: send the P2G4_MSG_RXV2_ADDRESSFOUND as usual, for the device to
+   *    evaluate it further (packets which do not pass are still rejected) */
+  uint8_t ask_device;
+} p2G4_rx_filter_t;
+
+typedef struct __attribute__ ((packed)) {
+  /* Byte offset in the packet */
+  uint16_t offset;
+  /* The rule matches if (packet[offset] & mask) == value */
+  uint8_t mask;
+  uint8_t value;
+} p2G4_rx_filter_rule_t;
+
+
+/*
+ * Registered address sets (see P2G4_MSG_ADDR_SET_REGISTER)
+ */
+typedef struct __attribute__ ((packed)) {
+  /* Handle of the set, chosen by the device, unique in this connection (never 0) */
+  uint32_t handle;
+  /* Number of p2G4_address_t which follow (only for P2G4_MSG_ADDR_SET_REGISTER, 0 otherwise) */
+  uint32_t n_addr;
+} p2G4_addr_set_t;
+
+
+/*
+ * Request templates (see P2G4_MSG_TMPL_REGISTER)
+ */
+typedef struct __attribute__ ((packed)) {
+  /* Handle of the template, chosen by the device, unique in this connection (never 0) */
+  uint32_t handle;
+  /* Which request this is a template of: P2G4_MSG_TX2V1 or P2G4_MSG_RX2V1
+   * Followed by the base p2G4_tx2v1_t, or p2G4_rx2v1_t and its n_addr addresses */
+  pc_header_t req;
+} p2G4_tmpl_t;
+
+/* Fields present in a P2G4_MSG_TMPL_INST, in this order */
+#define P2G4_TMPL_START  0x01 /* bs_time_t, new start_time (Rx) or start_tx_time (Tx) */
+#define P2G4_TMPL_FREQ   0x02 /* p2G4_freq2_t, new radio_params.center_freq */
+#define P2G4_TMPL_ABORT  0x04 /* p2G4_abort_t, new abort */
+#define P2G4_TMPL_POSTED 0x80 /* (no field) handle the Tx as a P2G4_MSG_TX2V1_POSTED */
+
+typedef struct __attribute__ ((packed)) {
+  /* Template to instantiate */
+  uint32_t handle;
+  /* Bitmask of P2G4_TMPL_* fields which follow */
+  uint8_t fields;
+} p2G4_tmpl_inst_t;
+
+
+/*
+ * Payload fetch (see P2G4_MSG_RX_PAYLOAD_REQ)
+ */
+typedef struct __attribute__ ((packed)) {
+  /* Offset of the first byte, and number of bytes
+   * (In the response, number of bytes which follow) */
+  uint16_t offset;
+  uint16_t size;
+} p2G4_rx_payload_t;
+
+
+/*
+ * Progressive payload delivery (see P2G4_MSG_RX_CHUNK)
+ */
+typedef struct __attribute__ ((packed)) {
+  /* Absolute us when the last bit of this chunk was received */
+  bs_time_t time;
+  /* Offset in the packet of the chunk first byte, and number of bytes which follow */
+  uint16_t offset;
+  uint16_t size;
+  /* Did any bit in this chunk have errors (1) or not (0) */
+  uint8_t bit_errors;
+} p2G4_rx_chunk_t;
+
+
+/*
+ * Bit error mask (see P2G4_MSG_RX_ERROR_MASK)
+ * Bits are numbered from the first bit of the packet payload (the LSB of its
+ * first byte), in the order they are sent over the air.
+ * As errors are rare at usual SNRs, the mask is sent as the list of runs of
+ * consecutive bits with errors (in increasing order, not overlapping).
+ */
+typedef struct __attribute__ ((packed)) {
+  /* Absolute us when the mask was calculated */
+  bs_time_t time;
+  /* First bit this mask covers (the device already has the runs before it).
+   * A run which started before this bit is cut to start at it */
+  uint32_t start_bit;
+  /* Number of bits of the packet for which errors have been calculated so far */
+  uint32_t calc_bits;
+  /* Number of p2G4_error_run_t which follow */
+  uint16_t n_runs;
+} p2G4_error_mask_t;
+
+typedef struct __attribute__ ((packed)) {
+  /* First bit with errors */
+  uint32_t bit;
+  /* Number of consecutive bits with errors */
+  uint16_t len;
+} p2G4_error_run_t;
+
+typedef struct __attribute__ ((packed)) {
+  /* The device already has the runs before this bit (see p2G4_error_mask_t) */
+  uint32_t start_bit;
+} p2G4_imm_error_mask_t;
+
+
+/*
+ * Chained transmissions (see P2G4_MSG_TX_CHAIN)
+ * Several back to back p2G4_tx2v1_t segments sent as one request, for packets
+ * which are made of several transmissions (Coded Phy, HDT, see the README).
+ * The segments must follow each other as required in the README:
+ *  {seg n}.end_tx_time = {seg n}.end_packet_time
+ *  {seg n+1}.start_tx_time = {seg n}.end_tx_time + 1
+ *  {seg n+1}.start_tx_time = {seg n+1}.start_packet_time
+ */
+#define P2G4_CHAIN_MAX_SEGS 32
+
+typedef struct __attribute__ ((packed)) {
+  /* Abort for the whole chain (the segments own abort is ignored) */
+  p2G4_abort_t abort;
+  /* Number of segments which follow (1..P2G4_CHAIN_MAX_SEGS) */
+  uint8_t n_segs;
+} p2G4_tx_chain_t;
+
+#define P2G4_SEGSTATUS_DONE     0x1 /* The segment was fully transmitted */
+#define P2G4_SEGSTATUS_ABORTED  0x2 /* The segment was aborted while being transmitted */
+#define P2G4_SEGSTATUS_NOT_SENT 0x3 /* The chain was aborted before the segment started */
+
+typedef struct __attribute__ ((packed)) {
+  /* absolute us this message is sent */
+  bs_time_t end_time;
+  /* Number of segments in the chain */
+  uint8_t n_segs;
+  /* One of P2G4_SEGSTATUS_* for each segment */
+  uint8_t status[P2G4_CHAIN_MAX_SEGS];
+} p2G4_tx_chain_done_t;
+
+
+/*
+ * Chained receptions (see P2G4_MSG_RX_CHAIN)
+ * A p2G4_rx2v1_t reception, followed by the reception of each of the next
+ * segments of the same packet (Coded Phy, HDT, see the README), as one request.
+ * Each next segment is received as if with a new p2G4_rx2v1_t with the same
+ * parameters as the first one, but with:
+ *   prelocked_tx = 1, start_time = previous segment end + 1,
+ *   pream_and_addr_duration = 0, acceptable_pre_truncation = 0,
+ *   scan_duration = 1, sync_threshold = UINT16_MAX, n_addr = 0,
+ *   and the fields in p2G4_rx_chain_seg_t
+ * The device is not asked to evaluate the header (no P2G4_MSG_RXV2_ADDRESSFOUND),
+ * and Rx filters (P2G4_MSG_RX_FILTER) do not apply to chains
+ */
+typedef struct __attribute__ ((packed)) {
+  uint32_t forced_packet_duration;
+  uint32_t error_calc_rate;
+  uint16_t coding_rate;
+  uint16_t header_duration;
+  uint16_t header_threshold;
+} p2G4_rx_chain_seg_t;
+
+typedef struct __attribute__ ((packed)) {
+  /* Number of p2G4_rx_chain_seg_t which follow the first segment
+   * (0..P2G4_CHAIN_MAX_SEGS-1) */
+  uint8_t n_next;
+} p2G4_rx_chain_t;
+
+typedef struct __attribute__ ((packed)) {
+  /* Result of the whole reception.
+   * rx_time_stamp, phy_address and rssi are those of the first segment.
+   * status is the one of the first segment which was not P2G4_RXSTATUS_OK (if any),
+   * and packet_size the sum of all segments sizes (the size of the payload which follows) */
+  p2G4_rxv2_done_t rx;
+  /* Number of segments in the chain (n_next + 1) */
+  uint8_t n_segs;
+  /* P2G4_RXSTATUS_* of each segment (P2G4_RXSTATUS_NOSYNC if not received) */
+  uint16_t seg_status[P2G4_CHAIN_MAX_SEGS];
+  /* Payload size of each segment */
+  uint16_t seg_size[P2G4_CHAIN_MAX_SEGS];
+} p2G4_rx_chain_done_t;
+
+
+/*
+ * Tx followed by Rx exchange (see P2G4_MSG_TXRX)
+ * For example a connection event, or a scan request followed by the wait
+ * for its response.
+ */
+typedef struct __attribute__ ((packed)) {
+  /* Abort for the whole exchange (the Tx and Rx own abort are ignored) */
+  p2G4_abort_t abort;
+  /* The Rx starts rx_delay us after the Tx ends
+   * (rx.start_time = tx.end_tx_time + rx_delay, the given rx.start_time is ignored) */
+  uint32_t rx_delay;
+  p2G4_tx2v1_t tx;
+  p2G4_rx2v1_t rx;
+} p2G4_txrx_t;
+
+typedef struct __attribute__ ((packed)) {
+  /* Note: If the device stops the Rx after a P2G4_MSG_RXV2_ADDRESSFOUND, the
+   * phy does not send a P2G4_MSG_TXRX_END (as for a normal Rx). The Tx
+   * was then fully transmitted (tx.end_time = tx.end_tx_time), or, for a
+   * P2G4_MSG_RX_AUTORESP, not sent (tx.end_time = TIME_NEVER) */
+  p2G4_tx_done_t tx;
+  /* If the Tx was aborted the Rx is not done (rx.status = P2G4_RXSTATUS_NOSYNC) */
+  p2G4_rxv2_done_t rx;
+} p2G4_txrx_done_t;
+
+/*
+ * Rx followed by an automatic response Tx (see P2G4_MSG_RX_AUTORESP)
+ * For example a SCAN_RSP after a SCAN_REQ, or a 15.4 ACK.
+ * The response is sent only if the packet is received with
+ * status P2G4_RXSTATUS_OK, its packet_size is in [min_len, max_len], and all
+ * the n_rules p2G4_rx_filter_rule_t match (as for P2G4_MSG_RX_FILTER)
+ */
+typedef struct __attribute__ ((packed)) {
+  /* Abort for the whole exchange (the Tx and Rx own abort are ignored) */
+  p2G4_abort_t abort;
+  /* The response Tx starts tx_delay us after the received packet ends
+   * (all tx times are shifted by the same amount so that
+   * start_tx_time = rx packet end + tx_delay) */
+  uint32_t tx_delay;
+  /* Accepted packet_size range (both included) */
+  uint16_t min_len;
+  uint16_t max_len;
+  /* Number of p2G4_rx_filter_rule_t in the condition (0..P2G4_RX_FILTER_MAX_RULES) */
+  uint8_t n_rules;
+  p2G4_rx2v1_t rx;
+  p2G4_tx2v1_t tx;
+} p2G4_rx_autoresp_t;
+
+
+/*
+ * CCA followed by a conditional Tx, listen before talk (see P2G4_MSG_CCA_TX)
+ * For example 802.15.4 CSMA-CA, or LBT regulated proprietary phys.
+ */
+#define P2G4_CCA_TX_MAX_BACKOFFS 8
+
+/* Which CCA outcomes mean the channel is busy (p2G4_cca_tx_t busy_on) */
+#define P2G4_CCA_TX_BUSY_MOD   0x01 /* mod_found */
+#define P2G4_CCA_TX_BUSY_RSSI  0x02 /* rssi_overthreshold */
+
+typedef struct __attribute__ ((packed)) {
+  /* Abort for the whole transaction (the CCA and Tx own abort are ignored) */
+  p2G4_abort_t abort;
+  /* The Tx starts tx_delay us after the end of a clear CCA
+   * (all tx times are shifted by the same amount so that
+   * start_tx_time = CCA end + tx_delay) */
+  uint32_t tx_delay;
+  /* P2G4_CCA_TX_BUSY_* */
+  uint8_t busy_on;
+  /* Number of uint32_t backoffs which follow (0..P2G4_CCA_TX_MAX_BACKOFFS).
+   * When a CCA finds the channel busy and there are backoffs left, the phy
+   * waits the next one (in us, from that CCA end) and repeats the CCA (with
+   * the same parameters). Otherwise the Tx is not done */
+  uint8_t n_backoffs;
+  p2G4_ccav2_t cca;
+  p2G4_tx2v1_t tx;
+} p2G4_cca_tx_t;
+
+typedef struct __attribute__ ((packed)) {
+  /* Result of the last CCA */
+  p2G4_cca_done_t cca;
+  /* Number of CCAs done (1 + used backoffs, 0 if aborted before the first one) */
+  uint8_t n_ccas;
+  /* tx.end_time is TIME_NEVER if the Tx was not started (channel busy,
+   * or aborted before) */
+  p2G4_tx_done_t tx;
+} p2G4_cca_tx_done_t;
+
+
+/*
+ * RSSI sweep over several frequencies (see P2G4_MSG_RSSI_SWEEP)
+ * For example a channel assessment over all the channels of a band, or, with
+ * freq_step = 0, a time series of samples in one channel
+ */
+#define P2G4_RSSI_SWEEP_MAX_POINTS 1024
+
+typedef struct __attribute__ ((packed)) {
+  /* Absolute us when the first measurement is taken.
+   * Measurement i is taken at start_time + i*meas_period */
+  bs_time_t start_time;
+  uint32_t meas_period;
+  /* Measurement i is taken in start_freq + i*freq_step, unless n_freqs > 0 */
+  p2G4_freq2_t start_freq;
+  p2G4_freq2_t freq_step;
+  /* Modulation the receiver is set to, for all measurements */
+  p2G4_modulation_t modulation;
+  p2G4_power_t antenna_gain;
+  /* Number of measurements (1..P2G4_RSSI_SWEEP_MAX_POINTS) */
+  uint16_t n_points;
+  /* Number of p2G4_freq2_t which follow (0, or n_points: measurement i is
+   * taken in the i-th one) */
+  uint16_t n_freqs;
+} p2G4_rssi_sweep_t;
+
+
+/*
+ * RSSI sampling during a reception (see P2G4_MSG_RX_RSSI_SERIES)
+ * For example for direction finding (CTE) or energy detection models
+ */
+#define P2G4_RSSI_SERIES_MAX_SAMPLES 1024
+
+/* What the p2G4_rssi_series_t start_time is relative to */
+#define P2G4_RSSI_SERIES_ABSOLUTE  0 /* Nothing, it is an absolute time */
+#define P2G4_RSSI_SERIES_FROM_SYNC 1 /* The end of the packet address (sync) */
+
+typedef struct __attribute__ ((packed)) {
+  /* When the first sample is taken. Sample i is taken at start_time + i*period */
+  bs_time_t start_time;
+  uint32_t period;
+  /* Number of samples (1..P2G4_RSSI_SERIES_MAX_SAMPLES) */
+  uint16_t n_samples;
+  /* One of P2G4_RSSI_SERIES_* */
+  uint8_t time_ref;
+} p2G4_rssi_series_t;
+
+typedef struct __attribute__ ((packed)) {
+  /* Absolute us of the first sample */
+  bs_time_t start_time;
+  uint32_t period;
+  /* Number of samples taken (which follow). Samples are only taken while the
+   * reception is ongoing, so this may be less than requested */
+  uint16_t n_samples;
+} p2G4_rssi_series_done_t;
+
+
+/*
+ * CCA over several frequencies (see P2G4_MSG_CCA_MULTI)
+ * For example LBT over a hopping set, or a multi-channel 15.4 energy scan
+ */
+#define P2G4_CCA_MULTI_MAX_FREQS 80
+
+/* How the channels are scanned (p2G4_cca_multi_t scan_mode) */
+/* All channels are measured at each scan_period */
+#define P2G4_CCA_MULTI_PARALLEL    0
+/* Measurement i (at start_time + i*scan_period) is done in channel i % n_freqs */
+#define P2G4_CCA_MULTI_ROUND_ROBIN 1
+
+/* To what cca.stop_when_found applies (p2G4_cca_multi_t stop_scope) */
+/* A channel stops being measured when its stop condition is met (the CCA
+ * ends once all have, or at the end of the scan_duration) */
+#define P2G4_CCA_MULTI_STOP_PER_CHANNEL 0
+/* The whole CCA ends as soon as any channel meets it */
+#define P2G4_CCA_MULTI_STOP_GLOBAL      1
+
+typedef struct __attribute__ ((packed)) {
+  /* CCA parameters, for all channels (cca.radio_params.center_freq is ignored) */
+  p2G4_ccav2_t cca;
+  /* Number of p2G4_freq2_t which follow (1..P2G4_CCA_MULTI_MAX_FREQS) */
+  uint8_t n_freqs;
+  /* One of P2G4_CCA_MULTI_PARALLEL or P2G4_CCA_MULTI_ROUND_ROBIN */
+  uint8_t scan_mode;
+  /* One of P2G4_CCA_MULTI_STOP_* */
+  uint8_t stop_scope;
+} p2G4_cca_multi_t;
+
+
+/*
+ * Reception with several independent receivers at the same time
+ * (see P2G4_MSG_RX_MULTI), for ex. a sniffer or a multi-radio device
+ * listening on several channels
+ */
+#define P2G4_RX_MULTI_MAX_RX 8
+
+typedef struct __attribute__ ((packed)) {
+  /* Abort for the whole request (each receiver rx.abort is ignored) */
+  p2G4_abort_t abort;
+  /* Number of p2G4_rx2v1_t which follow (1..P2G4_RX_MULTI_MAX_RX)
+   * Each receiver has its own radio parameters, start_time, scan_duration
+   * and addresses, and is evaluated by the phy as if the device accepted any
+   * packet with a matching address. All receivers shall have the same
+   * resp_type (without P2G4_RESP_ERROR_MASK, and not chunked) */
+  uint8_t n_rx;
+} p2G4_rx_multi_t;
+
+/* Precedes the p2G4_rxv2_done_t of each receiver in a P2G4_MSG_RX_MULTI_END */
+typedef struct __attribute__ ((packed)) {
+  /* Which receiver (index in the request) this completion is for */
+  uint8_t rx_idx;
+  /* Number of receivers still ongoing (0: the request is over) */
+  uint8_t n_left;
+} p2G4_rx_multi_tag_t;
+
+
+/*
+ * Multiplexed connections (see P2G4_MSG_MUX_START)
+ */
+typedef struct __attribute__ ((packed)) {
+  /* Number of devices multiplexed in this connection */
+  uint32_t n_devs;
+  /* Followed by n_devs uint32_t device numbers */
+} p2G4_mux_start_t;
+
+typedef struct __attribute__ ((packed)) {
+  /* Device number this message is from/for */
+  uint32_t dev_nbr;
+} p2G4_mux_tag_t;
+
+
 /*
  * Commands and responses IDs:
  */
@@ -765,6 +1243,14 @@ typedef struct __attribute__ ((packed)) {
 #define P2G4_MSG_TXV2           0x22
 /* The device will transmit (updated/v2.1 Tx API) */
 #define P2G4_MSG_TX2V1          0x23
+/* The device will transmit (v2.1 Tx API), but does not want a response:
+ * Same as P2G4_MSG_TX2V1 but the phy will not send a P2G4_MSG_TX_END.
+ * Only for transmissions which cannot be aborted (abort_time and
+ * recheck_time = TIME_NEVER), the device continues as if it had received
+ * a P2G4_MSG_TX_END with end_time = end_tx_time
+ * If the phy cannot perform it as requested, it sends a
+ * P2G4_MSG_TX_POSTED_FAIL ahead of its response to the device next request */
+#define P2G4_MSG_TX2V1_POSTED   0x24
 /* The device wants to attempt to receive (updated/v2 Rx API) */
 #define P2G4_MSG_RXV2           0x31
 /* The device wants to do a CCA check (new v2 API) */
@@ -773,6 +1259,138 @@ typedef struct __attribute__ ((packed)) {
 #define P2G4_MSG_RX2V1          0x33
 /* The device wants to do a CCAV2 check (updated/v2.1 API) */
 #define P2G4_MSG_CCAV2_MEAS       0x34
+/* The device wants to receive continuously (p2G4_rx_stream_t, followed by
+ * rx.n_addr p2G4_address_t, followed by n_channels p2G4_freq2_t) */
+#define P2G4_MSG_RX_STREAM        0x35
+
+/* The device asks to switch to the shared memory transport (see bs_pc_2G4_shm.h)
+ * Sent thru the FIFO. The phy responds, also thru the FIFO, with a
+ * P2G4_MSG_SHM_ATTACH_ACK (after which all following messages go thru the
+ * shared memory rings) or a P2G4_MSG_SHM_ATTACH_NACK (the FIFOs are kept) */
+#define P2G4_MSG_SHM_ATTACH     0x40
+/* The connection will carry the messages of several devices (see p2G4_mux_start_t)
+ * The phy responds, untagged, with a P2G4_MSG_MUX_START_ACK, after which all
+ * following messages, in both directions, are preceded by a p2G4_mux_tag_t,
+ * or with a P2G4_MSG_MUX_START_NACK (and the device disconnects) */
+#define P2G4_MSG_MUX_START      0x41
+/* Schedule of abort substructures for the next Tx, Rx or CCA request
+ * (p2G4_abort_sched_t followed by n_steps p2G4_abort_t).
+ * Each time the current recheck_time is reached, instead of sending a
+ * P2G4_MSG_ABORTREEVAL, the phy takes the next step as if the device had
+ * answered with it. Once all steps are used the phy reverts to asking the
+ * device. It is sent in the same frame as, right before, the request it
+ * applies to. The phy does not respond to this message */
+#define P2G4_MSG_ABORT_SCHED    0x42
+/* Header filter for the next v2/v2.1 Rx request (p2G4_rx_filter_t followed by
+ * n_rules p2G4_rx_filter_rule_t).
+ * When a packet address matches, instead of sending a
+ * P2G4_MSG_RXV2_ADDRESSFOUND, the phy evaluates the filter itself on the
+ * packet_size and the packet bytes. If it does not pass, the phy proceeds as
+ * if the device had answered P2G4_MSG_RXSTOP. If it passes, it continues as
+ * if it had answered P2G4_MSG_RXV2CONT with the current abort (unless
+ * ask_device is set), and as the device did not get the packet yet, the
+ * P2G4_MSG_RXV2_END is followed by it.
+ * Rules on bytes beyond the packet end do not match.
+ * It is sent in the same frame as, right before, the request it applies to.
+ * The phy does not respond to this message */
+#define P2G4_MSG_RX_FILTER      0x44
+/* Register a set of addresses (p2G4_addr_set_t followed by n_addr
+ * p2G4_address_t), with no limit in its size, to be used by later Rx requests.
+ * The phy keeps it (indexed in a hash table, with a Bloom pre-filter) until it is
+ * released or the device disconnects. The phy responds with
+ * P2G4_MSG_ADDR_SET_ACK or P2G4_MSG_ADDR_SET_NACK */
+#define P2G4_MSG_ADDR_SET_REGISTER 0x45
+/* Release a registered address set (p2G4_addr_set_t, n_addr = 0).
+ * The phy does not respond to this message */
+#define P2G4_MSG_ADDR_SET_RELEASE  0x46
+/* The next v2/v2.1 Rx request also matches any address in the given
+ * registered set (p2G4_addr_set_t, n_addr = 0), besides its own n_addr
+ * addresses (which may be 0). The matched address is reported as usual in the
+ * p2G4_rxv2_done_t phy_address. It is sent in the same frame as, right before,
+ * the request it applies to. The phy does not respond to this message */
+#define P2G4_MSG_RX_ADDR_SET       0x47
+/* Register a base request (p2G4_tmpl_t followed by the request, as it would
+ * be sent) for later P2G4_MSG_TMPL_INST. Templates are kept until the device
+ * disconnects. The phy does not respond to this message */
+#define P2G4_MSG_TMPL_REGISTER     0x48
+/* Request based on a registered template (p2G4_tmpl_inst_t followed by the
+ * updated fields, followed, for a Tx, by the packet payload).
+ * For a Tx, a new start_tx_time shifts all its times by the same amount.
+ * The phy handles it, and responds, as the equivalent full request */
+#define P2G4_MSG_TMPL_INST         0x49
+/* Fetch part of the payload of the packet being/last received
+ * (p2G4_rx_payload_t). Valid while the phy waits for the device response
+ * to a P2G4_MSG_RXV2_ADDRESSFOUND, or after the reception ended and before
+ * the next request. The phy responds with a P2G4_MSG_RX_PAYLOAD */
+#define P2G4_MSG_RX_PAYLOAD_REQ    0x4A
+/* Request the bit error mask of the packet being received so far
+ * (p2G4_imm_error_mask_t). Valid while the phy waits for the device response
+ * to a P2G4_MSG_ABORTREEVAL or P2G4_MSG_RXV2_ADDRESSFOUND (like
+ * P2G4_MSG_RERESP_IMMRSSI). The phy responds with a P2G4_MSG_RX_ERROR_MASK
+ * and continues waiting for the device response */
+#define P2G4_MSG_IMM_REQ_ERROR_MASK 0x4B
+/* Chained transmission (p2G4_tx_chain_t, followed by its n_segs p2G4_tx2v1_t,
+ * followed by all the segments payloads, one after the other).
+ * The phy handles the chain as one transaction (abort reevaluations included)
+ * and responds with a P2G4_MSG_TX_CHAIN_END */
+#define P2G4_MSG_TX_CHAIN          0x4C
+/* Chained reception (p2G4_rx_chain_t, followed by the first segment
+ * p2G4_rx2v1_t and its n_addr p2G4_address_t, followed by n_next
+ * p2G4_rx_chain_seg_t).
+ * The phy handles the chain as one transaction (abort reevaluations included)
+ * and responds with a P2G4_MSG_RX_CHAIN_END */
+#define P2G4_MSG_RX_CHAIN          0x4D
+/* Tx followed by Rx (p2G4_txrx_t, followed by the rx.n_addr p2G4_address_t,
+ * followed by the Tx packet payload).
+ * The phy handles both as one transaction: The Tx completes silently, and
+ * the Rx continues as a normal Rx2v1 (P2G4_MSG_RXV2_ADDRESSFOUND, Rx filters,
+ * payload options..) but ends with a P2G4_MSG_TXRX_END instead of a
+ * P2G4_MSG_RXV2_END. Abort reevaluations are sent during both */
+#define P2G4_MSG_TXRX              0x4E
+/* Rx followed by an automatic response Tx (p2G4_rx_autoresp_t, followed by the
+ * rx.n_addr p2G4_address_t, followed by n_rules p2G4_rx_filter_rule_t,
+ * followed by the response packet payload).
+ * The Rx proceeds as a normal Rx2v1, and if the packet meets the condition the
+ * phy transmits the response right after, without asking the device.
+ * As for a P2G4_MSG_TXRX, the phy handles both as one transaction and
+ * responds with a P2G4_MSG_TXRX_END (with tx.end_time = TIME_NEVER if the
+ * response was not sent) */
+#define P2G4_MSG_RX_AUTORESP       0x4F
+/* CCA followed by a conditional Tx (p2G4_cca_tx_t, followed by its n_backoffs
+ * uint32_t, followed by the packet payload).
+ * The phy handles the CCAs and the Tx as one transaction (abort reevaluations
+ * included) and responds with a P2G4_MSG_CCA_TX_END */
+#define P2G4_MSG_CCA_TX            0x50
+/* RSSI measurements over several frequencies (p2G4_rssi_sweep_t, followed by its
+ * n_freqs p2G4_freq2_t). The phy responds with a P2G4_MSG_RSSI_SWEEP_END */
+#define P2G4_MSG_RSSI_SWEEP        0x51
+/* RSSI samples to take during the next v2/v2.1 Rx request (p2G4_rssi_series_t),
+ * with that reception radio parameters and antenna gain. They are sent with a
+ * P2G4_MSG_RX_RSSI_SAMPLES right before the reception ends (none if the device
+ * stops it). It is sent in the same frame as, right before, the request it
+ * applies to. The phy does not respond to this message */
+#define P2G4_MSG_RX_RSSI_SERIES    0x52
+/* CCA over several frequencies (p2G4_cca_multi_t, followed by its n_freqs
+ * p2G4_freq2_t). Abort reevaluations are handled as for a CCA.
+ * The phy responds with a P2G4_MSG_CCA_MULTI_END */
+#define P2G4_MSG_CCA_MULTI         0x53
+/* Reception with several receivers at the same time (p2G4_rx_multi_t, followed
+ * by its n_rx p2G4_rx2v1_t, followed by the addresses of all receivers, in order).
+ * The phy responds with one P2G4_MSG_RX_MULTI_END per receiver, as each ends,
+ * and P2G4_MSG_ABORTREEVAL for the request abort */
+#define P2G4_MSG_RX_MULTI          0x54
+/* Answer to each P2G4_MSG_RX_STREAM_PACKET: the stream shall continue.
+ * (The phy does not continue a stream until it gets this or a
+ * P2G4_MSG_RX_STREAM_STOP) */
+#define P2G4_MSG_RX_STREAM_CONT    0x55
+/* Answer to a P2G4_MSG_RX_STREAM_PACKET: the device wants to end the stream.
+ * The stream ends at that packet end_time, and the phy acknowledges it with
+ * the P2G4_MSG_RX_STREAM_END */
+#define P2G4_MSG_RX_STREAM_STOP    0x56
+/* Answer to a P2G4_MSG_RXV2_ADDRESSFOUND during a stream: the device rejects
+ * this packet (as a P2G4_MSG_RXSTOP would in a normal Rx), and the stream
+ * continues. No P2G4_MSG_RX_STREAM_PACKET is sent for this packet */
+#define P2G4_MSG_RX_STREAM_SKIP    0x57
 
 /** From Phy to device **/
 /* Tx completed (fully or not) */
@@ -797,6 +1415,77 @@ typedef struct __attribute__ ((packed)) {
 #define P2G4_MSG_RXV2_END          0x113
 /* Search CCA check completed (new v2 API) */
 #define P2G4_MSG_CCA_END           0x114
+/* One reception of a stream completed (p2G4_rxv2_done_t).
+ * Followed by the packet payload, unless it was already sent with a
+ * P2G4_MSG_RXV2_ADDRESSFOUND for this packet.
+ * The device answers with P2G4_MSG_RX_STREAM_CONT or P2G4_MSG_RX_STREAM_STOP */
+#define P2G4_MSG_RX_STREAM_PACKET  0x115
+/* The reception stream ended (p2G4_rxv2_done_t, with packet_size 0), on its
+ * own, or acknowledging a P2G4_MSG_RX_STREAM_STOP */
+#define P2G4_MSG_RX_STREAM_END     0x116
+/* Response to P2G4_MSG_RX_PAYLOAD_REQ (p2G4_rx_payload_t, followed by its
+ * size bytes, which are less than requested if the packet is shorter) */
+#define P2G4_MSG_RX_PAYLOAD        0x117
+/* Part of the packet being received, for Rx requests with resp_type
+ * P2G4_RESP_PAYLOAD_CHUNKED (p2G4_rx_chunk_t followed by its bytes).
+ * Chunks end at the last byte fully received (by simulated bit time) when sent.
+ * To avoid waking the device for nothing, they are only sent right before each
+ * P2G4_MSG_ABORTREEVAL during the packet (each one with everything received
+ * since the previous), and a last one before the P2G4_MSG_RXV2_END.
+ * The device does not respond to this message */
+#define P2G4_MSG_RX_CHUNK          0x118
+/* Bit error mask of the packet being received (p2G4_error_mask_t followed by
+ * its n_runs p2G4_error_run_t).
+ * Response to P2G4_MSG_IMM_REQ_ERROR_MASK, or, for Rx requests with
+ * P2G4_RESP_ERROR_MASK, sent with the whole mask right before the reception
+ * ends. In that case the device does not respond to it */
+#define P2G4_MSG_RX_ERROR_MASK     0x119
+/* Chained transmission completed, fully or not (p2G4_tx_chain_done_t) */
+#define P2G4_MSG_TX_CHAIN_END      0x11A
+/* Chained reception completed (p2G4_rx_chain_done_t, followed by the payload of
+ * all the received segments, one after the other, as per the first segment resp_type) */
+#define P2G4_MSG_RX_CHAIN_END      0x11B
+/* Tx followed by Rx, or Rx followed by its automatic response, completed
+ * (p2G4_txrx_done_t, followed by the packet as for a P2G4_MSG_RXV2_END) */
+#define P2G4_MSG_TXRX_END          0x11C
+/* CCA followed by a conditional Tx completed (p2G4_cca_tx_done_t) */
+#define P2G4_MSG_CCA_TX_END        0x11D
+/* RSSI sweep completed (n_points p2G4_rssi_power_t, one per measurement, in order) */
+#define P2G4_MSG_RSSI_SWEEP_END    0x11E
+/* RSSI samples taken during the reception (p2G4_rssi_series_done_t followed by
+ * its n_samples p2G4_rssi_power_t), sent right before the P2G4_MSG_RXV2_END
+ * (or equivalent end of the reception) for Rx requests preceded by a
+ * P2G4_MSG_RX_RSSI_SERIES. The device does not respond to this message */
+#define P2G4_MSG_RX_RSSI_SAMPLES   0x11F
+/* CCA over several frequencies completed (n_freqs p2G4_cca_done_t, one per
+ * channel in the request order, each with the time its measurements ended) */
+#define P2G4_MSG_CCA_MULTI_END     0x120
+/* One receiver of a P2G4_MSG_RX_MULTI ended (p2G4_rx_multi_tag_t, followed by
+ * its p2G4_rxv2_done_t, followed by its packet as per the request resp_type) */
+#define P2G4_MSG_RX_MULTI_END      0x121
+/* The phy accepts a P2G4_MSG_SHM_ATTACH (sent thru the FIFO, its last message
+ * in it): all following messages, in both directions, go thru the rings */
+#define P2G4_MSG_SHM_ATTACH_ACK    0x122
+/* The phy rejects a P2G4_MSG_SHM_ATTACH (for ex. it did not create that shared
+ * memory object): the device shall continue using the FIFOs */
+#define P2G4_MSG_SHM_ATTACH_NACK   0x123
+/* A P2G4_MSG_TX2V1_POSTED could not be performed as requested (followed by
+ * the p2G4_tx_done_t the P2G4_MSG_TX_END would have had). Sent right before
+ * the response to the device next request. As the device already continued
+ * assuming it went fine, it will disconnect */
+#define P2G4_MSG_TX_POSTED_FAIL    0x124
+/* The phy accepts a P2G4_MSG_MUX_START (untagged, its last untagged message) */
+#define P2G4_MSG_MUX_START_ACK     0x125
+/* The phy rejects a P2G4_MSG_MUX_START (for ex. one of the devices is already
+ * connected on its own): the device shall disconnect */
+#define P2G4_MSG_MUX_START_NACK    0x126
+/* The phy registered the address set of a P2G4_MSG_ADDR_SET_REGISTER
+ * (followed by p2G4_addr_set_t, n_addr = 0) */
+#define P2G4_MSG_ADDR_SET_ACK      0x127
+/* The phy could not register that address set (for ex. it is out of memory, or
+ * the handle is in use) (followed by p2G4_addr_set_t, n_addr = 0): the handle
+ * shall not be used */
+#define P2G4_MSG_ADDR_SET_NACK     0x128
 
 #ifdef __cplusplus
 }